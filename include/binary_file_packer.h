@@ -38,14 +38,13 @@ protected:
     virtual bool IsDuplicated(const std::unique_ptr<FileEntry> &entry, std::string subPath);
     PackageParser packageParser_;
     std::string moduleName_;
-    std::mutex mutex_;
 
 private:
     uint32_t CopyBinaryFile(const std::string &filePath, const std::string &fileType);
     uint32_t CopyBinaryFileImpl(const std::string &src, const std::string &dst);
     uint32_t CopySingleFile(const std::string &path, std::string &subPath);
     std::future<uint32_t> copyFuture_;
-    std::vector<std::future<uint32_t>> copyResults_;
+    TaskGroup copyTasks_;
     std::atomic<bool> terminate_{false};
     uint32_t result_ = RESTOOL_SUCCESS;
 };
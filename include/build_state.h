@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_RESTOOL_BUILD_STATE_H
+#define OHOS_RESTOOL_BUILD_STATE_H
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "resource_item.h"
+#include "singleton.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+/**
+ * State of the last successful build for the incremental mode, saved in the output directory.
+ * Inputs are identified by path, size, mtime and content hash. An unchanged input reuses the
+ * items or the output file of the last build.
+ */
+class BuildState : public Singleton<BuildState> {
+public:
+    /**
+     * @brief enable the incremental mode and load the state of the last build.
+     * @param output: output directory of the build.
+     * @param options: options that affect the outputs, the last state is discarded if they changed.
+     * @param dependencies: files that affect the outputs, the last state is discarded if one of them changed.
+     */
+    void Load(const std::string &output, const std::string &options, const std::vector<std::string> &dependencies);
+
+    /**
+     * @brief save the state of this build, and remove the outputs of the last build that are not produced again.
+     * @return RESTOOL_SUCCESS if success, other RESTOOL_ERROR.
+     */
+    uint32_t Save();
+
+    bool IsEnabled() const;
+    bool HasLastState() const;
+
+    /**
+     * @brief get the items compiled from an input that is unchanged since the last build.
+     * @param input: input file path.
+     * @param items: cached items.
+     * @return true if the input is unchanged, other false.
+     */
+    bool GetItems(const std::string &input, std::vector<ResourceItem> &items);
+    void SetItems(const std::string &input, const std::vector<ResourceItem> &items);
+
+    /**
+     * @brief get the output file of an input that is unchanged since the last build.
+     * @param input: input file path.
+     * @param output: output file path, it still exists.
+     * @return true if the input is unchanged, other false.
+     */
+    bool GetOutput(const std::string &input, std::string &output);
+
+    /**
+     * @brief set the output file of an input.
+     * @param input: input file path.
+     * @param output: output file path in the resources directory.
+     * @param cache: intermediate file of the output, such as the transcoded image in the caches directory, it is
+     *        removed with the output but not needed to reuse it. Empty if there is none.
+     */
+    void SetOutput(const std::string &input, const std::string &output, const std::string &cache = "");
+
+    const std::map<std::pair<ResType, std::string>, int64_t> &GetIds() const;
+    void SetIds(const std::map<std::pair<ResType, std::string>, int64_t> &ids);
+
+private:
+    struct Fingerprint {
+        uint64_t size = 0;
+        int64_t mtime = 0;
+        uint64_t hash = 0;
+    };
+
+    struct Entry {
+        Fingerprint fingerprint;
+        std::vector<std::string> outputs;
+        std::vector<ResourceItem> items;
+    };
+
+    const Entry *FindUnchanged(const std::string &input, Fingerprint &fingerprint) const;
+    void Record(const std::string &input, Entry &&entry, bool reused);
+    bool Parse(const char *data, size_t length);
+    void Serialize(std::string &buffer) const;
+    std::string GetDependencyKey(const std::vector<std::string> &dependencies) const;
+    static bool GetStat(const std::string &path, Fingerprint &fingerprint);
+    static bool GetHash(const std::string &path, uint64_t &hash);
+    static bool GetFingerprint(const std::string &path, Fingerprint &fingerprint);
+
+    bool enabled_ = false;
+    bool hasLastState_ = false;
+    std::string statePath_;
+    std::string options_;
+    std::mutex mutex_;
+    std::map<std::string, Entry> last_;
+    std::map<std::string, Entry> current_;
+    std::map<std::pair<ResType, std::string>, int64_t> ids_;
+    size_t reused_ = 0;
+};
+}
+}
+}
+#endif
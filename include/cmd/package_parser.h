@@ -53,6 +53,9 @@ public:
     const std::string &GetCompressionPath() const;
     bool IsOverlap() const;
     size_t GetThreadCount() const;
+    bool IsIncremental() const;
+    const std::string &GetTranscodeCachePath() const;
+    const std::string &GetTracePath() const;
 
 private:
     void InitCommand();
@@ -86,6 +89,9 @@ private:
     uint32_t AddCompressionPath(const std::string &argValue);
     uint32_t ParseThread(const std::string &argValue);
     uint32_t ParseIgnoreRegex(const std::string &argValue, const std::string &option);
+    uint32_t SetIncremental();
+    uint32_t SetTranscodeCachePath(const std::string &argValue);
+    uint32_t SetTracePath(const std::string &argValue);
 
     static const struct option CMD_OPTS[];
     static const std::string CMD_PARAMS;
@@ -111,6 +117,9 @@ private:
     std::string compressionPath_;
     size_t threadCount_{ 0 };
     bool isOverlap_{ false };
+    bool isIncremental_{ false };
+    std::string transcodeCachePath_;
+    std::string tracePath_;
 };
 } // namespace Restool
 } // namespace Global
@@ -17,6 +17,9 @@
 #define OHOS_RESTOOL_COMPRESSION_PARSER_H
 
 #include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <cJSON.h>
 #ifdef __WIN32
 #include <windows.h>
@@ -71,13 +74,43 @@ public:
     virtual ~CompressionParser();
     uint32_t Init();
     bool CopyAndTranscode(const std::string &src, std::string &dst, const bool extAppend = false);
+
+    /**
+     * @brief copy a media file into the resources, transcoded if a filter matches it.
+     * @param src: source file path.
+     * @param dst: destination in the resources, the copied file in the resources on return, its extension
+     *        is the one of the transcoded format.
+     * @param cache: the transcoded file in the caches directory on return, empty if it is not transcoded.
+     * @param extAppend: append the extension of the transcoded format instead of replacing it.
+     * @return true if success, other false.
+     */
+    bool CopyAndTranscode(const std::string &src, std::string &dst, std::string &cache, const bool extAppend);
     bool GetMediaSwitch();
     std::string PrintTransMessage();
     bool GetDefaultCompress();
     void SetOutPath(const std::string &path);
+    void SetCachePath(const std::string &path);
     bool ScaleIconEnable();
     bool CheckAndScaleIcon(const std::string &src, const std::string &originDst, std::string &scaleDst);
+
+    /**
+     * @brief get the transcode options a file is expected to use, files of the same group are best transcoded
+     * together, because the options are only set again when they change.
+     * @param src: source file path.
+     * @return group of the file, empty if the file is not transcoded.
+     */
+    std::string GetTranscodeGroup(const std::string &src);
 private:
+    struct TranscodeStatistics {
+        unsigned long long totalTime = 0;
+        uint32_t totalCounts = 0;
+        unsigned long long compressTime = 0;
+        uint32_t compressCounts = 0;
+        unsigned long long successTime = 0;
+        uint32_t successCounts = 0;
+        unsigned long long originalSize = 0;
+        unsigned long long successSize = 0;
+    };
     bool ParseContext(const cJSON *contextNode);
     bool ParseCompression(const cJSON *compressionNode);
     bool ParseFilters(const cJSON *filtersNode);
@@ -86,14 +119,19 @@ private:
     TranscodeError TranscodeImages(const std::string &imagePath, const bool extAppend,
         std::string &outputPath, TranscodeResult &result);
     TranscodeError ScaleImage(const std::string &imagePath, std::string &outputPath);
+    static void PrintTranscodeWarning(TranscodeError ret, const std::string &imagePath);
+    bool Transcode(const std::string &src, const std::string &optionJson, const std::string &optionJsonExclude,
+        const bool extAppend, std::string &output, TranscodeResult &result, TranscodeError &res);
     std::vector<std::string> ParsePath(const cJSON *pathNode);
     std::string ParseRules(const cJSON *rulesNode);
     std::string ParseJsonStr(const cJSON *node);
     bool CheckPath(const std::string &src, const std::vector<std::string> &paths);
     bool IsInPath(const std::string &src, const std::shared_ptr<CompressFilter> &compressFilter);
     bool IsInExcludePath(const std::string &src, const std::shared_ptr<CompressFilter> &compressFilter);
-    void CollectTime(uint32_t &count, unsigned long long &time,
-        std::chrono::time_point<std::chrono::steady_clock> &start);
+    bool AcquireOptions(const std::string &optionJson, const std::string &optionJsonExclude);
+    void ReleaseOptions();
+    TranscodeStatistics &GetStatistics();
+    void CollectTime(std::chrono::time_point<std::chrono::steady_clock> &start);
     void CollectTimeAndSize(TranscodeError res, std::chrono::time_point<std::chrono::steady_clock> &start,
         TranscodeResult &result);
     std::string GetMethod(const std::shared_ptr<CompressFilter> &compressFilter);
@@ -102,7 +140,7 @@ private:
     std::string GetFileRules(const std::string &rules, const std::string &method);
     bool CheckAndTranscode(const std::string &src, std::string &dst, std::string &output,
         const std::shared_ptr<CompressFilter> &compressFilter, const bool extAppend);
-    bool CopyForTrans(const std::string &src, const std::string &originDst, const std::string &dst);
+    bool CopyForTrans(const std::string &src, const std::string &dst, std::string &output);
     bool IsDefaultCompress();
     std::string filePath_;
     std::string extensionPath_;
@@ -111,14 +149,21 @@ private:
     cJSON *root_;
     bool defaultCompress_;
     std::string outPath_;
-    unsigned long long totalTime_ = 0;
-    uint32_t totalCounts_ = 0;
-    unsigned long long compressTime_ = 0;
-    uint32_t compressCounts_ = 0;
-    unsigned long long successTime_ = 0;
-    uint32_t successCounts_ = 0;
-    unsigned long long originalSize_ = 0;
-    unsigned long long successSize_ = 0;
+    std::string cachePath_;
+    // the transcoder keeps one set of options for the process, the transcodes of the current options run
+    // concurrently, other options wait until they are done
+    std::mutex optionsMutex_;
+    std::condition_variable optionsCondition_;
+    bool hasOptions_ = false;
+    std::string optionJson_;
+    std::string optionJsonExclude_;
+    uint32_t activeTranscodes_ = 0;
+    std::map<std::pair<std::string, std::string>, uint32_t> waitingOptions_;
+    uint32_t waitingCount_ = 0;
+    // statistics of each thread, merged by PrintTransMessage
+    std::mutex statisticsMutex_;
+    std::vector<std::unique_ptr<TranscodeStatistics>> statistics_;
+    uint64_t instanceId_;
 #ifdef __WIN32
     HMODULE handle_ = nullptr;
 #else
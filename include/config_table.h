@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_RESTOOL_CONFIG_TABLE_H
+#define OHOS_RESTOOL_CONFIG_TABLE_H
+
+#include <deque>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "resource_data.h"
+#include "singleton.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+/**
+ * Interned qualifier configs. The resource items of a qualifier directory share one config, so they
+ * are grouped and compared by integer ids instead of limit key strings.
+ */
+class ConfigTable : public Singleton<ConfigTable> {
+public:
+    struct Config {
+        uint32_t id = 0; // 0 is the empty config
+        uint32_t limitKeyId = 0; // equal ids if and only if equal limit keys
+        std::string limitKey;
+        std::shared_ptr<const std::vector<KeyParam>> keyParams; // never null
+    };
+
+    /**
+     * @brief get the interned config of a limit key and its key params, the config lives until exit.
+     * @param limitKey: limit key, such as "base" or "zh_CN".
+     * @param keyParams: key params parsed from the limit key.
+     * @return interned config.
+     */
+    const Config *Intern(const std::string &limitKey, const std::vector<KeyParam> &keyParams);
+
+    /**
+     * @brief same as above, a new config shares the key params instead of copying them.
+     * @param limitKey: limit key, such as "base" or "zh_CN".
+     * @param keyParams: immutable key params parsed from the limit key, not null.
+     * @return interned config.
+     */
+    const Config *Intern(const std::string &limitKey, const std::shared_ptr<const std::vector<KeyParam>> &keyParams);
+    static const Config &GetEmpty();
+
+private:
+    static std::string GetKey(const std::string &limitKey, const std::vector<KeyParam> &keyParams);
+    const Config *InternInner(const std::string &limitKey, const std::vector<KeyParam> &keyParams,
+        std::shared_ptr<const std::vector<KeyParam>> shared);
+    std::shared_mutex mutex_;
+    std::deque<Config> configs_;
+    std::unordered_map<std::string, const Config *> configIndex_;
+    std::unordered_map<std::string, uint32_t> limitKeyIds_;
+};
+}
+}
+}
+#endif
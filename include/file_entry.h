@@ -58,8 +58,11 @@ public:
     static bool Exist(const std::string &path);
     static bool RemoveAllDir(const std::string &path);
     static bool RemoveFile(const std::string &path);
+    static bool RemoveEmptyDir(const std::string &path);
     static bool CreateDirs(const std::string &path);
     static bool CopyFileInner(const std::string &src, const std::string &dst);
+    // same as CopyFileInner, but only returns false with errno set on failure instead of printing an error
+    static bool TryCopyFile(const std::string &src, const std::string &dst);
     static bool IsDirectory(const std::string &path);
     static std::string RealPath(const std::string &path);
     static std::string AdaptLongPath(const std::string &path);
@@ -68,7 +71,10 @@ public:
 private:
     bool IsIgnore(const std::string &filename) const;
     static bool RemoveAllDirInner(const FileEntry &entry);
-    static bool CreateDirsInner(const std::string &path, std::string::size_type offset);
+    static bool MakeDir(const std::string &path, bool &parentMissing);
+#ifndef _WIN32
+    static bool CopyFileData(int in, int out, size_t size);
+#endif
 #ifdef _WIN32
     static std::wstring AdaptLongPathW(const std::string &path);
     static std::string Wstring2String(const std::wstring &wstr, const int codePage = CP_UTF8);
@@ -16,6 +16,7 @@
 #ifndef OHOS_RESTOOL_FILE_MANAGER_H
 #define OHOS_RESTOOL_FILE_MANAGER_H
 
+#include <set>
 #include <vector>
 #include "resource_data.h"
 #include "resource_item.h"
@@ -44,9 +45,10 @@ public:
     void SetScanHap(bool state);
 
 private:
-    uint32_t ScanModule(const std::string &input, const std::string &output);
     uint32_t ParseReference(const std::string &output);
-    void CheckAllItems(std::vector<std::pair<ResType, std::string>> &noBaseResource);
+    void CheckItems(const std::map<int64_t, std::vector<ResourceItem>> &merged,
+        std::vector<std::pair<ResType, std::string>> &noBaseResource,
+        std::set<std::pair<ResType, std::string>> &noBaseSet) const;
     bool ScaleIcon(const std::string &output, ResourceItem &item);
 
     // id, resource items
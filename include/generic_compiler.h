@@ -36,7 +36,7 @@ protected:
     std::mutex mutex_;
 
 private:
-    bool CopyMediaFile(const FileInfo &fileInfo, std::string &output);
+    bool CopyMediaFile(const FileInfo &fileInfo, std::string &output, std::string &cache);
 };
 }
 }
@@ -51,7 +51,13 @@ protected:
     std::map<std::pair<ResType, std::string>, std::vector<ResourceItem>> nameInfos_;
 
 private:
+    struct ListResult {
+        bool success = true;
+        std::string errors;
+        std::vector<FileInfo> fileInfos;
+    };
     uint32_t PostCommit();
+    static bool ListFiles(const DirectoryInfo &directoryInfo, std::vector<FileInfo> &fileInfos);
 };
 }
 }
@@ -16,6 +16,7 @@
 #ifndef OHOS_RESTOOL_ID_WORKER_H
 #define OHOS_RESTOOL_ID_WORKER_H
 
+#include <unordered_set>
 #include <vector>
 #include "id_defined_parser.h"
 #include "resource_data.h"
@@ -34,6 +35,8 @@ public:
     int64_t GetId(ResType resType, const std::string &name) const;
     int64_t GetSystemId(ResType resType, const std::string &name) const;
     int64_t LoadIdFromHap(std::map<int64_t, std::vector<ResourceItem>> &items);
+    void SetCacheIds(const std::map<std::pair<ResType, std::string>, int64_t> &ids);
+    const std::map<std::pair<ResType, std::string>, int64_t> &GetIds() const;
 
 private:
     int64_t GenerateAppId(ResType resType, const std::string &name);
@@ -46,8 +49,9 @@ private:
     std::map<std::pair<ResType, std::string>, int64_t> ids_;
     std::map<std::pair<ResType, std::string>, ResourceId> sysDefinedIds_;
     std::map<std::pair<ResType, std::string>, ResourceId> appDefinedIds_;
-    std::vector<int64_t> delIds_;
     std::map<std::pair<ResType, std::string>, int64_t> cacheIds_;
+    // ids of id_defined.json and of the last build, skipped when a new id is allocated
+    std::unordered_set<int64_t> reservedIds_;
 };
 }
 }
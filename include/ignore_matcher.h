@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_RESTOOL_IGNORE_MATCHER_H
+#define OHOS_RESTOOL_IGNORE_MATCHER_H
+
+#include <map>
+#include <regex>
+#include <string>
+#include "resource_data.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+/**
+ * Ignore patterns compiled once. Patterns are added while parsing the command line,
+ * after that the matcher is only read and can be shared by all threads.
+ */
+class IgnoreMatcher {
+public:
+    struct MatchResult {
+        const std::string *pattern = nullptr;
+        bool isPath = false;
+    };
+
+    IgnoreMatcher() = default;
+    explicit IgnoreMatcher(const std::map<std::string, IgnoreType> &patterns);
+
+    /**
+     * @brief compile and add a pattern, the pattern has to match the whole name.
+     * @param pattern: ECMAScript regex pattern.
+     * @param ignoreType: the ignore file type.
+     * @param errMsg: the regex error when the pattern is invalid.
+     * @return true if success, other false.
+     */
+    bool AddPattern(const std::string &pattern, IgnoreType ignoreType, std::string &errMsg);
+
+    /**
+     * @brief find the first pattern matching the file name, or the file path if matchPath is set.
+     * @param fileName: file name.
+     * @param filePath: file path with '/' separators.
+     * @param isFile: whether it is a file or a directory.
+     * @param matchPath: whether to match the file path too.
+     * @return the matched pattern, pattern is nullptr if nothing matched.
+     */
+    MatchResult Match(const std::string &fileName, const std::string &filePath, bool isFile, bool matchPath) const;
+
+private:
+    enum class MatchKind {
+        LITERAL,
+        PREFIX,
+        SUFFIX,
+        REGEX
+    };
+
+    struct Pattern {
+        IgnoreType ignoreType = IgnoreType::IGNORE_ALL;
+        MatchKind kind = MatchKind::REGEX;
+        std::string literal;
+        size_t minWildcardLen = 0;
+        std::regex regex;
+    };
+
+    static bool ParseLiteral(const std::string &pattern, std::string &literal);
+    static void Classify(const std::string &source, Pattern &pattern);
+    static bool IsWildcard(const std::string &str, size_t pos, size_t len);
+    static bool IsMatch(const Pattern &pattern, const std::string &name);
+    std::map<std::string, Pattern> patterns_;
+};
+}
+}
+}
+#endif
@@ -17,6 +17,8 @@
 #define OHOS_RESTOOL_JSON_COMPILER_H
 
 #include <functional>
+#include <string>
+#include <vector>
 #include <cJSON.h>
 #include "i_resource_compiler.h"
 #include "resource_util.h"
@@ -30,10 +32,21 @@ public:
     virtual ~JsonCompiler();
 protected:
     uint32_t CompileSingleFile(const FileInfo &fileInfo) override;
+    uint32_t CompileFiles(const std::vector<FileInfo> &fileInfos) override;
 private:
+    struct ParseResult {
+        bool success = true;
+        bool isBaseString = false;
+        std::vector<ResourceItem> items; // parsed items in file order, merged by MergeParseResult
+        std::string errors; // errors printed while parsing, replayed after the items are merged
+    };
+
     void InitParser();
-    bool ParseJsonArrayLevel(const cJSON *arrayNode, const FileInfo &fileInfo);
-    bool ParseJsonObjectLevel(cJSON *objectNode, const FileInfo &fileInfo);
+    void ParseFile(const FileInfo &fileInfo, ParseResult &result) const;
+    bool ParseRoot(cJSON *root, const FileInfo &fileInfo, ParseResult &result) const;
+    uint32_t MergeParseResult(const ParseResult &result);
+    bool ParseJsonArrayLevel(const cJSON *arrayNode, const FileInfo &fileInfo, ParseResult &result) const;
+    bool ParseJsonObjectLevel(cJSON *objectNode, const FileInfo &fileInfo, ParseResult &result) const;
 
     using HandleResource = std::function<bool(const cJSON *, ResourceItem&)>;
     bool HandleString(const cJSON *objectNode, ResourceItem &resourceItem) const;
@@ -62,8 +75,6 @@ private:
     bool CheckPluralValue(const cJSON *arrayItem, const ResourceItem &resourceItem) const;
     bool CheckColorValue(const char *s) const;
     std::map<ResType, HandleResource> handles_;
-    bool isBaseString_;
-    cJSON *root_;
 };
 }
 }
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_RESTOOL_JSON_DOCUMENT_H
+#define OHOS_RESTOOL_JSON_DOCUMENT_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cJSON.h>
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+/**
+ * Json document for reading. The file is parsed from a memory-mapped buffer into cJSON nodes allocated in an
+ * arena, so the tree is walked with the cJSON API. A string value may be shortened in place, but nodes must not
+ * be added, replaced or passed to cJSON_Delete.
+ * The parser accepts strict json only, any other document is parsed by cJSON, so the accepted documents,
+ * the values and the errors are the same as ResourceUtil::OpenJsonFile.
+ */
+class JsonDocument {
+public:
+    JsonDocument() = default;
+    JsonDocument(const JsonDocument &) = delete;
+    JsonDocument &operator=(const JsonDocument &) = delete;
+    virtual ~JsonDocument();
+
+    /**
+     * @brief load a json file.
+     * @param path: json file path.
+     * @return true if success, other false.
+     */
+    bool Load(const std::string &path);
+    cJSON *GetRoot() const;
+
+private:
+    bool Parse(const char *data, size_t length);
+    bool ParseValue(cJSON *node, size_t depth);
+    bool ParseString(char *&value);
+    bool ParseNumber(cJSON *node);
+    bool ParseArray(cJSON *node, size_t depth);
+    bool ParseObject(cJSON *node, size_t depth);
+    bool ParseLiteral(const char *literal, size_t length);
+    void SkipWhitespace();
+    cJSON *NewNode();
+    void *Allocate(size_t size);
+    void Reset();
+
+    const char *pos_ = nullptr;
+    const char *end_ = nullptr;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char *blockPos_ = nullptr;
+    size_t blockFree_ = 0;
+    cJSON *root_ = nullptr;
+    bool isArena_ = false;
+};
+}
+}
+}
+#endif
@@ -16,6 +16,9 @@
 #ifndef OHOS_RESTOOL_KEY_PARSER_H
 #define OHOS_RESTOOL_KEY_PARSER_H
 
+#include <memory>
+#include <shared_mutex>
+#include <unordered_map>
 #include <vector>
 #include "resource_data.h"
 
@@ -25,6 +28,14 @@ namespace Restool {
 class KeyParser {
 public:
     static bool Parse(const std::string &folderName, std::vector<KeyParam> &keyparams);
+
+    /**
+     * @brief parse the key params of a qualifier directory name, the results are cached and safe to share
+     * between threads.
+     * @param folderName: qualifier directory name, such as "zh_CN-phone-sdpi".
+     * @return immutable key params, nullptr if the folder name is not a valid qualifier.
+     */
+    static std::shared_ptr<const std::vector<KeyParam>> Parse(const std::string &folderName);
     static bool ParseLimit(const std::string &func, std::vector<std::string> &limitValues,
         TargetConfig &targetConfig);
 
@@ -55,7 +66,9 @@ private:
     static const int32_t SCRIPT_LENGHT = 4;
     static const int32_t MIN_REGION_LENGHT = 2;
     static const int32_t MAX_REGION_LENGHT = 3;
-    static std::map<std::string, std::vector<KeyParam>> caches_;
+    // invalid folder names are cached as nullptr
+    static std::unordered_map<std::string, std::shared_ptr<const std::vector<KeyParam>>> caches_;
+    static std::shared_mutex cachesMutex_;
 };
 }
 }
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_RESTOOL_MAPPED_FILE_H
+#define OHOS_RESTOOL_MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#ifdef _WIN32
+#include "windows.h"
+#endif
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+    virtual ~MappedFile();
+
+    /**
+     * @brief map the whole file read-only into memory.
+     * @param path: file path.
+     * @param printError: if true, print error message.
+     * @return true if success, other false. empty file is reported as an error.
+     */
+    bool Open(const std::string &path, bool printError = true);
+    void Close();
+    const char *GetData() const;
+    size_t GetSize() const;
+
+private:
+    const char *data_ = nullptr;
+    size_t size_ = 0;
+#ifdef _WIN32
+    HANDLE hFile_ = INVALID_HANDLE_VALUE;
+    HANDLE hFileMap_ = nullptr;
+#endif
+};
+}
+}
+}
+#endif
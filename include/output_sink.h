@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_RESTOOL_OUTPUT_SINK_H
+#define OHOS_RESTOOL_OUTPUT_SINK_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include "file_entry.h"
+#include "singleton.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+/**
+ * Writes the output files. A file that already has the new content is left untouched, so its mtime is kept
+ * and the downstream steps see it as unchanged. The files written under the resources directory are recorded
+ * in a manifest, so the next build can keep the directory and only remove the files it does not write again.
+ */
+class OutputSink : public Singleton<OutputSink> {
+public:
+    /**
+     * @brief write a file unless it already has the same content.
+     * @param path: output file path.
+     * @param data: file content.
+     * @param length: content length.
+     * @return true if success, other false.
+     */
+    bool Write(const std::string &path, const char *data, size_t length);
+    bool Write(const std::string &path, const std::string &content);
+
+    /**
+     * @brief write a file unless it already has the same content.
+     * @param path: output file path.
+     * @param data: file content.
+     * @param length: content length.
+     * @param written: bytes written to the file, 0 if the file is left untouched.
+     * @return true if success, other false.
+     */
+    bool Write(const std::string &path, const char *data, size_t length, size_t &written);
+
+    /**
+     * @brief copy a file unless the destination already has the same content.
+     * @param src: source file path.
+     * @param dst: destination file path.
+     * @return true if success, other false.
+     */
+    bool Copy(const std::string &src, const std::string &dst);
+
+    /**
+     * @brief record a file that is kept from the last build without being written.
+     * @param path: output file path.
+     */
+    void Keep(const std::string &path);
+
+    /**
+     * @brief load and remove the manifest of the last build, it is saved again by Reconcile after this build.
+     * @param output: output directory.
+     * @param record: whether the files of this build are recorded.
+     * @return true if the manifest of the last build is loaded and lists every file of the resources directory,
+     *         the directory can be reconciled then instead of being removed.
+     */
+    bool LoadManifest(const std::string &output, bool record);
+
+    /**
+     * @brief remove the files of the last build that are not written by this build, then save the manifest.
+     * @return RESTOOL_SUCCESS if success, other RESTOOL_ERROR.
+     */
+    uint32_t Reconcile();
+
+    /**
+     * @brief print the count and the bytes of the files written and skipped.
+     */
+    void PrintStatistics() const;
+
+private:
+    static bool IsSame(const std::string &path, const char *data, size_t length);
+    static bool IsSame(const std::string &src, const std::string &dst, uint64_t &size);
+    void Count(uint64_t size, bool skipped);
+    void Record(const std::string &path);
+    bool IsListed(const FileEntry &dir) const;
+    uint32_t RemoveStaleFiles(const std::vector<std::string> &staleFiles) const;
+
+    std::atomic<uint64_t> writtenFiles_{ 0 };
+    std::atomic<uint64_t> writtenBytes_{ 0 };
+    std::atomic<uint64_t> skippedFiles_{ 0 };
+    std::atomic<uint64_t> skippedBytes_{ 0 };
+    bool recording_ = false;
+    std::string output_;
+    std::string resourcesPrefix_;
+    std::string manifestPath_;
+    std::unordered_set<std::string> lastFiles_;
+    std::mutex filesMutex_;
+    std::unordered_set<std::string> files_; // relative to the output directory
+};
+}
+}
+}
+#endif
@@ -16,6 +16,7 @@
 #ifndef OHOS_RESTOOL_REFERENCE_PARSER_H
 #define OHOS_RESTOOL_REFERENCE_PARSER_H
 
+#include <string_view>
 #include <cJSON.h>
 #include "id_worker.h"
 #include "resource_data.h"
@@ -34,7 +35,16 @@ public:
     uint32_t ParseRefInString(std::string &value, bool &update, const std::string &filePath = "") const;
     static std::map<int64_t, std::set<int64_t>> &GetLayerIconIds();
 private:
+    struct RefResult {
+        bool success = true;
+        std::string errors;
+        std::map<int64_t, std::set<int64_t>> layerIconIds;
+    };
+    uint32_t ParseRefInItem(ResourceItem &resourceItem, const std::string &output, RefResult &result);
+    uint32_t ParseRefInJsonFile(ResourceItem &resourceItem, const std::string &output, const bool isIncrement,
+        std::map<int64_t, std::set<int64_t>> &layerIconIds);
     bool ParseRefJson(const std::string &from, const std::string &to);
+    bool ParseRefJson(cJSON *root, const std::string &from, const std::string &to) const;
     bool ParseRefResourceItemData(const ResourceItem &resourceItem, std::string &data, bool &update) const;
     bool IsStringOfResourceItem(ResType resType) const;
     bool IsArrayOfResourceItem(ResType resType) const;
@@ -43,16 +53,14 @@ private:
     bool IsProfileRef(const ResourceItem &resourceItem) const;
     bool ParseRefString(std::string &key) const;
     bool ParseRefString(std::string &key, bool &update, const std::string &filePath = "") const;
-    bool ParseRefImpl(std::string &key, const std::map<std::string, ResType> &refs, bool isSystem,
+    bool SplitRef(const std::string &key, size_t typePos, std::string_view &type, size_t &namePos) const;
+    bool ParseRefImpl(std::string &key, std::string_view type, size_t namePos, bool isSystem,
         const std::string &filePath = "") const;
     bool ParseRefJsonImpl(cJSON *root, bool &needSave, const std::string &filePath) const;
     const IdWorker &idWorker_;
-    static const std::map<std::string, ResType> ID_REFS;
-    static const std::map<std::string, ResType> ID_OHOS_REFS;
+    static const std::map<std::string, ResType, std::less<>> REF_TYPES; // <type, ResType>
     static std::map<int64_t, std::set<int64_t>> layerIconIds_;
-    cJSON *root_;
-    bool isParsingMediaJson_;
-    int64_t mediaJsonId_{ INVALID_ID };
+    std::set<int64_t> *mediaLayerIcons_; // media referenced by the layered icon json being parsed
 };
 }
 }
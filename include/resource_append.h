@@ -17,6 +17,7 @@
 #define OHOS_RESTOOL_RESOURCE_APPEND_H
 
 #include <fstream>
+#include <string_view>
 #include "cmd/package_parser.h"
 #include "resource_compiler_factory.h"
 #include "file_entry.h"
@@ -56,15 +57,12 @@ private:
     bool WriteRawFilesOrResFiles(const std::string &filePath, const std::string &outputPath, const std::string &limit);
     bool Push(const std::shared_ptr<ResourceItem> &resourceItem);
     void AddRef(const std::shared_ptr<ResourceItem> &resourceItem);
-    bool LoadResourceItemFromMem(const char buffer[], int32_t length);
-    std::string ParseString(const char buffer[], int32_t length, int32_t &offset) const;
-    int32_t ParseInt32(const char buffer[], int32_t length, int32_t &offset) const;
+    bool LoadResourceItemFromMem(const char buffer[], size_t length);
+    std::string_view ParseString(const char buffer[], size_t length, size_t &offset) const;
+    int32_t ParseInt32(const char buffer[], size_t length, size_t &offset) const;
     bool ParseRef();
     bool CheckModuleResourceItem(const std::shared_ptr<ResourceItem> &resourceItem, int64_t id);
     bool IsBaseIdDefined(const FileInfo &fileInfo);
-#ifdef __WIN32
-    bool LoadResourceItemWin(const std::string &filePath);
-#endif
     void CheckAllItems(std::vector<std::pair<ResType, std::string>> &noBaseResource);
     const PackageParser &packageParser_;
     std::map<int64_t, std::vector<std::shared_ptr<ResourceItem>>> items_;
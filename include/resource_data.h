@@ -18,6 +18,7 @@
 
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <set>
 #include <stdint.h>
 #include <string>
@@ -53,8 +54,6 @@ static const std::string RESTOOLV2_NAME = "RestoolV2";
 static const std::string RESTOOL_VERSION = { " 6.1.0.003" };
 const static int32_t TAG_LEN = 4;
 constexpr static int DEFAULT_POOL_SIZE = 8;
-static std::set<std::string> g_resourceSet;
-static std::set<std::string> g_hapResourceSet;
 const static int8_t INVALID_ID = -1;
 const static int MIN_SUPPORT_NEW_MODULE_API_VERSION = 20;
 const static int MIN_SUPPORT_TS_HEADER_API_VERSION = 23;
@@ -161,6 +160,9 @@ enum Option {
     THREAD = 8,
     IGNORED_FILE = 9,
     IGNORED_PATH = 10,
+    INCREMENTAL = 11,
+    TRANSCODE_CACHE = 12,
+    TRACE = 13,
     STARTID = 'e',
     FORCEWRITE = 'f',
     HELP = 'h',
@@ -324,7 +326,7 @@ struct DirectoryInfo {
     std::string limitKey;
     std::string fileCluster;
     std::string dirPath;
-    std::vector<KeyParam> keyParams;
+    std::shared_ptr<const std::vector<KeyParam>> keyParams; // shared by the directories of a limit key
     ResType dirType;
 };
 
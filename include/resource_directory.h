@@ -19,6 +19,7 @@
 #include <functional>
 #include <string>
 #include <map>
+#include <vector>
 #include "key_parser.h"
 
 namespace OHOS {
@@ -30,8 +31,13 @@ public:
     virtual ~ResourceDirectory() {};
     bool ScanResources(const std::string &resourcesDir, std::function<bool(const DirectoryInfo&)> callback) const;
 private:
+    struct ScanResult {
+        bool success = true;
+        std::string errors;
+        std::vector<DirectoryInfo> directoryInfos;
+    };
     bool ScanResourceLimitKeyDir(const std::string &resourceTypeDir, const std::string &limitKey,
-        std::function<bool(const DirectoryInfo&)> callback) const;
+        std::vector<DirectoryInfo> &directoryInfos) const;
 };
 }
 }
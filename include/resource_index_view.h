@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_RESTOOL_RESOURCE_INDEX_VIEW_H
+#define OHOS_RESTOOL_RESOURCE_INDEX_VIEW_H
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "mapped_file.h"
+#include "resource_item.h"
+#include "restool_errors.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+/**
+ * Read-only view of a resources.index (V1 or V2). Only the id table is indexed when opened,
+ * resource values are decoded on demand straight from the mapped buffer.
+ */
+class ResourceIndexView {
+public:
+    struct Entry {
+        uint32_t id = 0;
+        ResType type = ResType::INVALID_RES_TYPE;
+        std::string_view name;
+        uint32_t offset = 0; // V2: ResInfo offset, V1: first index in values_
+        uint32_t count = 0; // V1: value count, V2: unused
+    };
+
+    struct Value {
+        const std::vector<KeyParam> *keyParams = nullptr;
+        const int8_t *data = nullptr;
+        uint32_t length = 0;
+    };
+
+    ResourceIndexView() = default;
+    ResourceIndexView(const ResourceIndexView &) = delete;
+    ResourceIndexView &operator=(const ResourceIndexView &) = delete;
+    virtual ~ResourceIndexView() = default;
+
+    /**
+     * @brief map and index a resources.index file.
+     * @param path: resources.index path.
+     * @return RESTOOL_SUCCESS if success, other RESTOOL_ERROR.
+     */
+    uint32_t Open(const std::string &path);
+
+    /**
+     * @brief index a resources.index already in memory, the buffer must outlive the view.
+     * @param data: buffer of resources.index.
+     * @param length: buffer length.
+     * @return RESTOOL_SUCCESS if success, other RESTOOL_ERROR.
+     */
+    uint32_t Open(const char *data, size_t length);
+
+    bool IsNewModule() const;
+
+    /**
+     * @brief all resources sorted by id, names point into the index buffer.
+     */
+    const std::vector<Entry> &GetEntries() const;
+    const Entry *FindById(uint32_t id) const;
+    const Entry *FindByName(ResType type, std::string_view name) const;
+
+    /**
+     * @brief decode the values of a resource without copying the data.
+     * @param entry: entry from this view.
+     * @param values: values in the index order.
+     * @return true if success, other false.
+     */
+    bool GetValues(const Entry &entry, std::vector<Value> &values) const;
+
+    /**
+     * @brief materialize the resource items of an id.
+     * @param id: resource id.
+     * @param items: output resource items, empty if the id is not found.
+     * @return RESTOOL_SUCCESS if success, other RESTOOL_ERROR.
+     */
+    uint32_t GetResourceItems(uint32_t id, std::vector<ResourceItem> &items) const;
+    uint32_t LoadAll(std::map<int64_t, std::vector<ResourceItem>> &resInfos) const;
+
+private:
+    struct ValueRef {
+        uint32_t id;
+        uint32_t keyIndex;
+        uint32_t dataOffset;
+    };
+
+    template<typename T>
+    bool Read(uint64_t pos, T &value) const;
+    uint32_t Index(const char *data, size_t length);
+    bool IndexV1();
+    bool IndexV2();
+    bool ReadV1Record(const ValueRef &ref, ResType &type, std::string_view &name) const;
+    bool GetValuesV1(const Entry &entry, std::vector<Value> &values) const;
+    bool GetValuesV2(const Entry &entry, std::vector<Value> &values) const;
+    bool AppendItems(const Entry &entry, std::vector<ResourceItem> &items) const;
+    void BuildNameIndex();
+    void Reset();
+
+    MappedFile file_;
+    const char *data_ = nullptr;
+    uint64_t length_ = 0;
+    bool newModule_ = false;
+    std::vector<Entry> entries_;
+    std::map<std::pair<ResType, std::string_view>, size_t> nameIndex_;
+    std::vector<std::vector<KeyParam>> keyConfigs_;
+    std::unordered_map<uint32_t, uint32_t> configIndex_; // V2: <configId, index of keyConfigs_>
+    std::vector<ValueRef> values_;
+};
+}
+}
+}
+#endif
@@ -16,7 +16,11 @@
 #ifndef OHOS_RESTOOL_RESOURCE_ITEM_H
 #define OHOS_RESTOOL_RESOURCE_ITEM_H
 
+#include <atomic>
+#include <cstddef>
+#include <memory>
 #include <vector>
+#include "config_table.h"
 #include "resource_data.h"
 
 namespace OHOS {
@@ -26,7 +30,13 @@ class ResourceItem {
 public:
     ResourceItem();
     ResourceItem(const ResourceItem &other);
+    ResourceItem(ResourceItem &&other) noexcept;
     ResourceItem(const std::string &name, const std::vector<KeyParam> &keyparams, ResType type);
+    // intern the config of the limit key once, instead of the constructor above followed by SetLimitKey
+    ResourceItem(const std::string &name, const std::string &limitKey, const std::vector<KeyParam> &keyparams,
+        ResType type);
+    ResourceItem(const std::string &name, const std::string &limitKey,
+        const std::shared_ptr<const std::vector<KeyParam>> &keyparams, ResType type);
     virtual ~ResourceItem();
 
     bool SetData(const std::string &data);
@@ -43,6 +53,8 @@ public:
     const std::vector<KeyParam> &GetKeyParam() const;
     const std::string &GetFilePath() const;
     const std::string &GetLimitKey() const;
+    uint32_t GetLimitKeyId() const;
+    uint32_t GetConfigId() const;
     bool IsCoverable() const;
     const std::vector<std::string> SplitValue() const;
     bool IsArray() const;
@@ -50,16 +62,23 @@ public:
     void CheckData();
 
     ResourceItem &operator=(const ResourceItem &other);
+    ResourceItem &operator=(ResourceItem &&other) noexcept;
 private:
+    // the data is never modified once set, so copies share it, the reference count is stored before the data
+    struct alignas(std::max_align_t) DataHeader {
+        std::atomic<uint32_t> refCount;
+    };
+    static DataHeader *GetDataHeader(const int8_t *data);
     void ReleaseData();
     void CopyFrom(const ResourceItem &other);
+    void MoveFrom(ResourceItem &other);
     int8_t *data_ = nullptr;
     uint32_t dataLen_ = 0;
     std::string name_;
-    std::vector<KeyParam> keyparams_;
     ResType type_;
     std::string filePath_;
-    std::string limitKey_;
+    // interned limit key and key params, shared by the items of a qualifier directory
+    const ConfigTable::Config *config_ = &ConfigTable::GetEmpty();
     bool coverable_ = false;
 };
 }
@@ -28,6 +28,19 @@ public:
     ResourceModule(const std::string &modulePath, const std::string &moduleOutput, const std::string &moduleName);
     virtual ~ResourceModule() {};
     uint32_t ScanResource(bool isHap = false);
+
+    /**
+     * @brief scan the resource directories of the module, safe to run concurrently for different modules.
+     * @return RESTOOL_SUCCESS if success, other RESTOOL_ERROR.
+     */
+    uint32_t ScanDirectorys();
+
+    /**
+     * @brief compile the scanned directories, ids are generated here, so modules are compiled in input order.
+     * @param isHap: whether the module is a hap.
+     * @return RESTOOL_SUCCESS if success, other RESTOOL_ERROR.
+     */
+    uint32_t CompileDirectorys(bool isHap = false);
     const std::map<int64_t, std::vector<ResourceItem>> &GetOwner() const;
     const std::map<ResType, std::vector<DirectoryInfo>> &GetScanDirectorys() const;
     static uint32_t MergeResourceItem(std::map<int64_t, std::vector<ResourceItem>> &alls,
@@ -19,6 +19,7 @@
 #include "config_parser.h"
 #include "resource_append.h"
 #include "resource_data.h"
+#include "resource_index_view.h"
 #include "resource_item.h"
 #include "resource_merge.h"
 #include "resource_util.h"
@@ -43,6 +44,8 @@ protected:
 
 private:
     uint32_t InitModule();
+    void InitBuildState() const;
+    uint32_t SaveBuildState() const;
     void InitHeaderCreater();
     uint32_t InitOutput() const;
     uint32_t InitCompression();
@@ -57,7 +60,7 @@ private:
     uint32_t PackAppend();
     uint32_t PackCombine();
     uint32_t HandleFeature();
-    uint32_t FindResourceItems(const std::map<int64_t, std::vector<ResourceItem>> &resInfoLocal,
+    uint32_t FindResourceItems(const ResourceIndexView &indexView,
                                std::vector<ResourceItem> &items, int64_t id) const;
     uint32_t HandleLabel(std::vector<ResourceItem> &items, ConfigParser &config) const;
     uint32_t HandleIcon(std::vector<ResourceItem> &items, ConfigParser &config) const;
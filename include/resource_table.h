@@ -35,7 +35,6 @@ public:
     uint32_t CreateResourceTable();
     uint32_t CreateResourceTable(const std::map<int64_t, std::vector<std::shared_ptr<ResourceItem>>> &items);
     static uint32_t LoadResTable(const std::string path, std::map<int64_t, std::vector<ResourceItem>> &resInfos);
-    static uint32_t LoadResTable(std::basic_istream<char> &in, std::map<int64_t, std::vector<ResourceItem>> &resInfos);
 private:
     struct TableData {
         uint32_t id;
@@ -43,7 +42,7 @@ private:
     };
 
     struct IndexHeader {
-        int8_t version[VERSION_MAX_LEN];
+        int8_t version[VERSION_MAX_LEN] = {};
         uint32_t fileSize;
         uint32_t limitKeyConfigSize;
     };
@@ -77,7 +76,7 @@ private:
 
     struct IndexHeaderV2 {
         static const uint32_t INDEX_HEADER_LEN = VERSION_MAX_LEN + 12;
-        int8_t version[VERSION_MAX_LEN];
+        int8_t version[VERSION_MAX_LEN] = {};
         uint32_t length = 0;
         uint32_t keyCount = 0;
         uint32_t dataBlockOffset = 0;
@@ -127,6 +126,26 @@ private:
         std::unordered_map<uint32_t, ResInfo> resInfos; // <resID, ResInfo>
     };
 
+    class IndexWriter {
+    public:
+        explicit IndexWriter(uint32_t size);
+        bool IsValid() const;
+        void Seek(uint32_t pos);
+        void Write(const void *src, uint32_t len);
+        bool IsOverflow() const;
+        const int8_t *GetData() const;
+        uint32_t GetSize() const; // end of the bytes filled in
+        uint32_t GetCapacity() const; // allocated buffer size
+    private:
+        std::unique_ptr<int8_t[]> buffer_;
+        uint32_t size_ = 0;
+        uint32_t pos_ = 0;
+        uint32_t end_ = 0;
+        bool overflow_ = false;
+    };
+
+    static void GroupByLimitKey(std::unordered_map<uint32_t, std::vector<TableData>> &groups,
+        std::map<std::string, std::vector<TableData>> &configs);
     uint32_t SaveToResouorceIndex(const std::map<std::string, std::vector<TableData>> &configs) const;
     uint32_t SaveToNewResouorceIndex(const std::map<std::string, std::vector<TableData>> &configs) const;
     uint32_t CreateIdDefined(const std::map<int64_t, std::vector<ResourceItem>> &allResource) const;
@@ -140,17 +159,6 @@ private:
     void SaveLimitKeyConfigs(const std::map<std::string, LimitKeyConfig> &limitKeyConfigs,
                              std::ostringstream &out) const;
     void SaveIdSets(const std::map<std::string, IdSet> &idSets, std::ostringstream &out) const;
-    static bool ReadFileHeader(std::basic_istream<char> &in, IndexHeader &indexHeader, uint64_t &pos, uint64_t length);
-    static bool ReadLimitKeys(std::basic_istream<char> &in, std::map<int64_t, std::vector<KeyParam>> &limitKeys,
-        uint32_t count, uint64_t &pos, uint64_t length);
-    static bool ReadIdTables(std::basic_istream<char> &in, std::map<int64_t, std::pair<int64_t, int64_t>> &datas,
-        uint32_t count, uint64_t &pos, uint64_t length);
-    static bool ReadDataRecordPrepare(std::basic_istream<char> &in, RecordItem &record,
-        uint64_t &pos, uint64_t length);
-    static bool ReadDataRecordStart(std::basic_istream<char> &in, RecordItem &record,
-        const std::map<int64_t, std::vector<KeyParam>> &limitKeys,
-        const std::map<int64_t, std::pair<int64_t, int64_t>> &datas,
-        std::map<int64_t, std::vector<ResourceItem>> &resInfos);
     static bool InitHeader(IndexHeaderV2 &indexHeader, IdSetHeader &idSetHeader,
         DataHeader &dataHeader, uint32_t count);
     static void PrepareKeyConfig(IndexHeaderV2 &indexHeader, const uint32_t configId,
@@ -158,29 +166,15 @@ private:
     static void PrepareResIndex(IdSetHeader &idSetHeader, const TableData &tableData);
     static void PrepareResInfo(DataHeader &dataHeader, const uint32_t resId,
         const uint32_t configId, const uint32_t dataPoolLen);
-    static void WriteDataPool(std::ostringstream &dataPool, const ResourceItem &resourceItem, uint32_t &dataPoolLen);
-    static void WriteResInfo(std::ostringstream &dataBlock, const DataHeader &idSetHeader,
+    static void WriteDataPool(IndexWriter &writer, const std::map<std::string, std::vector<TableData>> &configs);
+    static void WriteResInfo(IndexWriter &writer, const DataHeader &dataHeader,
         const uint32_t dataBlockOffset, std::unordered_map<uint32_t, uint32_t> &idOffsetMap);
-    static void WriteIdSet(std::ostringstream &idSetBlock, const IdSetHeader &idSetHeader,
+    static void WriteIdSet(IndexWriter &writer, const IdSetHeader &idSetHeader,
                         const std::unordered_map<uint32_t, uint32_t> &idOffsetMap);
-    static void WriteResHeader(std::ostringstream &resHeaderBlock, const IndexHeaderV2 &indexHeader);
-    static void WriteToIndex(const IndexHeaderV2 &indexHeader, const IdSetHeader &idSetHeader,
-                const DataHeader &dataHeader, const std::ostringstream &dataPool, std::ofstream &out);
-    static bool IsNewModule(const IndexHeader &indexHeader);
-    static uint32_t LoadNewResTable(std::basic_istream<char> &in,
-        std::map<int64_t, std::vector<ResourceItem>> &resInfos);
-    static bool ReadNewFileHeader(std::basic_istream<char> &in, IndexHeaderV2 &indexHeader,
-        uint64_t &pos, uint64_t length);
-    static bool ReadIdSetHeader(std::basic_istream<char> &in, IdSetHeader &idSetHeader,
-        uint64_t &pos, uint64_t length);
-    static bool ReadResources(std::basic_istream<char> &in, const ResIndex &resIndex,
-        const ResTypeHeader &resTypeHeader, IndexHeaderV2 &indexHeader, uint64_t length,
-        std::map<int64_t, std::vector<ResourceItem>> &resInfos);
-    static bool ReadResInfo(std::basic_istream<char> &in, ResInfo &resInfo, uint32_t offset, uint64_t length);
-    static bool ReadResConfig(std::basic_istream<char> &in, uint32_t &resConfigId, uint32_t &dataOffset,
-        uint64_t &pos, uint64_t length);
-    static bool ReadResourceItem(std::basic_istream<char> &in, ResourceItem &resourceItem, uint32_t dataOffset,
-        uint64_t &pos, uint64_t length);
+    static void WriteResHeader(IndexWriter &writer, const IndexHeaderV2 &indexHeader);
+    static bool WriteToIndex(const IndexHeaderV2 &indexHeader, const IdSetHeader &idSetHeader,
+        const DataHeader &dataHeader, const std::map<std::string, std::vector<TableData>> &configs,
+        IndexWriter &writer);
     std::string indexFilePath_;
     std::string idDefinedPath_;
     bool newResIndex_ = false;
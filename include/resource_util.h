@@ -139,7 +139,7 @@ public:
     static bool CopyFileInner(const std::string &src, const std::string &dst);
 
     /**
-     * @brief create directories
+     * @brief create directories, a directory created before is not checked again
      * @param filePath: directory path
      * @return true if success, other false
      */
@@ -208,6 +208,19 @@ void InitFaq(const std::string &restoolPath);
 ErrorInfo GetError(const uint32_t &errCode);
 void PrintError(const uint32_t &errCode);
 void PrintError(const ErrorInfo &error);
+
+/**
+ * @brief redirect the errors printed by the current thread, so that concurrent tasks can be replayed in order.
+ * @param buffer: errors are appended to buffer instead of stderr, nullptr restores stderr.
+ * @return the previous buffer of the current thread, a nested task restores it when done.
+ */
+std::string *SetErrorBuffer(std::string *buffer);
+
+/**
+ * @brief replay errors collected by SetErrorBuffer, to the buffer of the current thread if it has one.
+ * @param errors: collected errors.
+ */
+void PrintErrors(const std::string &errors);
 }
 }
 }
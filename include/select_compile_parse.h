@@ -25,7 +25,7 @@ class SelectCompileParse {
 public:
     static uint32_t ParseTargetConfig(const std::string &limitParams, const std::string &optionName);
     static bool HasTargetConfig();
-    static bool IsSelectCompile(std::vector<KeyParam> &keyParams);
+    static bool IsSelectCompile(const std::vector<KeyParam> &keyParams);
 
 private:
     static bool ParseTargetConfigInner(const std::string &limitParams);
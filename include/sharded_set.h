@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_RESTOOL_SHARDED_SET_H
+#define OHOS_RESTOOL_SHARDED_SET_H
+
+#include <array>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+/**
+ * A string set that can be used from any thread. The strings are spread over shards by hash, each shard
+ * has its own lock, so threads inserting different strings rarely wait for each other. A key is hashed
+ * once when it is made, before any lock is taken.
+ */
+class ShardedSet {
+public:
+    struct Key {
+        std::string value;
+        size_t hash;
+    };
+
+    /**
+     * @brief make the key of a string.
+     * @param value: the string.
+     * @return the key.
+     */
+    static Key MakeKey(std::string value);
+
+    /**
+     * @brief insert a key.
+     * @param key: the key.
+     * @return true if the key is inserted, false if it exists.
+     */
+    bool Insert(const Key &key);
+
+    /**
+     * @brief erase a key.
+     * @param key: the key.
+     * @return true if the key is erased, false if it does not exist.
+     */
+    bool Erase(const Key &key);
+
+    bool Contains(const Key &key) const;
+    size_t Size() const;
+    void Clear();
+
+private:
+    struct KeyHash {
+        size_t operator()(const Key &key) const
+        {
+            return key.hash;
+        }
+    };
+    struct KeyEqual {
+        bool operator()(const Key &left, const Key &right) const
+        {
+            return left.hash == right.hash && left.value == right.value;
+        }
+    };
+    static constexpr size_t SHARD_BITS = 6;
+    static constexpr size_t SHARD_COUNT = 1 << SHARD_BITS;
+    // one cache line per shard, so the locks of neighbouring shards do not share a line
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        std::unordered_set<Key, KeyHash, KeyEqual> keys;
+    };
+    Shard &GetShard(size_t hash);
+    const Shard &GetShard(size_t hash) const;
+    static size_t GetShardIndex(size_t hash);
+
+    std::array<Shard, SHARD_COUNT> shards_;
+};
+
+// output paths of the resources already emitted by the build, and those emitted by the hap of overlap mode
+extern ShardedSet g_resourceSet;
+extern ShardedSet g_hapResourceSet;
+}
+}
+}
+#endif
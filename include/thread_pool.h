@@ -16,18 +16,29 @@
 #ifndef OHOS_RESTOOL_THREAD_POOL_H
 #define OHOS_RESTOOL_THREAD_POOL_H
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <string>
 #include <thread>
 #include <vector>
+#include "restool_errors.h"
 
 namespace OHOS {
 namespace Global {
 namespace Restool {
+/**
+ * Work-stealing thread pool. Each worker owns a deque, tasks enqueued by a worker are pushed to its own deque
+ * and run LIFO, idle workers steal FIFO from the others. Tasks enqueued from outside the pool go to a shared
+ * queue. A thread waiting for a task group runs the queued tasks of that group instead of blocking, so a task
+ * may wait for the tasks it enqueued even with a single worker.
+ */
 class ThreadPool {
 public:
     ~ThreadPool();
@@ -51,19 +62,90 @@ public:
     template <class F, class... Args>
     std::future<typename std::result_of<F(Args...)>::type> Enqueue(F &&f, Args &&...args);
 
+    /**
+     * @brief Run f(0) ... f(count - 1) on the thread pool and wait for them, the items are shared by
+     *        one task per worker instead of one task per item
+     * @param count the count of items
+     * @param f the function to execute, returns RESTOOL_SUCCESS or RESTOOL_ERROR
+     * @return RESTOOL_SUCCESS if all items succeed, other RESTOOL_ERROR
+     */
+    template <class F>
+    uint32_t ParallelFor(size_t count, F &&f);
+
+    /**
+     * @brief Wait for a future of a pool task. A thread outside the pool blocks, a worker runs pending tasks
+     *        of the pool while waiting, without its error buffer
+     * @param future the future to wait
+     */
+    template <class T>
+    void Wait(const std::future<T> &future);
+
+    size_t GetThreadCount() const;
+
     static ThreadPool &GetInstance();
 
 private:
+    friend class TaskGroup;
+    struct Worker {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
     ThreadPool();
     ThreadPool(const ThreadPool &) = delete;
     ThreadPool &operator=(const ThreadPool &) = delete;
-    void WorkInThread();
+    void Push(std::function<void()> task);
+    bool Pop(std::function<void()> &task);
+    bool RunPendingTask();
+    bool IsWorker() const;
+    void RunTask(std::function<void()> &task);
+    void WorkInThread(size_t index);
     std::vector<std::thread> workerThreads_;
-    std::queue<std::function<void()>> tasks_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::deque<std::function<void()>> tasks_; // tasks enqueued from outside the pool
+    std::atomic<size_t> pending_{ 0 };
 
     std::mutex queueMutex_;
     std::condition_variable condition_;
-    bool running_{ false };
+    std::atomic<bool> running_{ false };
+};
+
+/**
+ * Tasks that are waited for together, without a future per task. The tasks are kept by the group until they
+ * start, the pool only runs a handle that takes the next one, so a waiter only runs the tasks of its own group.
+ * The destructor waits for the tasks.
+ */
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool &pool = ThreadPool::GetInstance());
+    ~TaskGroup();
+    TaskGroup(const TaskGroup &) = delete;
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+    /**
+     * @brief Enqueue a task to the thread pool
+     * @param f the function to execute, returns RESTOOL_SUCCESS or RESTOOL_ERROR
+     */
+    template <class F>
+    void Run(F &&f);
+
+    /**
+     * @brief Wait for all the tasks of the group, run the queued tasks while waiting
+     * @return RESTOOL_SUCCESS if all tasks succeed, other RESTOOL_ERROR
+     */
+    uint32_t Wait();
+
+private:
+    struct State {
+        std::mutex mutex;
+        std::condition_variable condition;
+        std::deque<std::function<uint32_t()>> tasks; // tasks not started yet
+        size_t pending = 0; // tasks not finished yet
+        bool failed = false;
+    };
+    static bool RunNext(State &state);
+    ThreadPool &pool_;
+    std::shared_ptr<State> state_;
 };
 
 template <typename F, typename... Args>
@@ -74,12 +156,61 @@ std::future<typename std::result_of<F(Args...)>::type> ThreadPool::Enqueue(F &&f
     auto task = std::make_shared<p_task>(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
 
     std::future<return_type> res = task->get_future();
+    Push([task]() { (*task)(); });
+    return res;
+}
+
+template <class F>
+uint32_t ThreadPool::ParallelFor(size_t count, F &&f)
+{
+    std::atomic<size_t> next{ 0 };
+    auto runner = [&next, &f, count]() {
+        uint32_t result = RESTOOL_SUCCESS;
+        for (size_t i = next++; i < count; i = next++) {
+            if (f(i) != RESTOOL_SUCCESS) {
+                result = RESTOOL_ERROR;
+            }
+        }
+        return result;
+    };
+    TaskGroup group(*this);
+    size_t taskCount = std::min(count, workers_.size());
+    for (size_t i = 1; i < taskCount; i++) {
+        group.Run(runner);
+    }
+    uint32_t result = runner();
+    if (group.Wait() != RESTOOL_SUCCESS) {
+        return RESTOOL_ERROR;
+    }
+    return result;
+}
+
+template <class T>
+void ThreadPool::Wait(const std::future<T> &future)
+{
+    if (!IsWorker()) {
+        future.wait();
+        return;
+    }
+    // a worker that only blocked could wait for a task queued behind it
+    while (future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        if (!RunPendingTask()) {
+            future.wait_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+template <class F>
+void TaskGroup::Run(F &&f)
+{
     {
-        std::unique_lock<std::mutex> lock(queueMutex_);
-        tasks_.emplace([task]() { (*task)(); });
+        std::lock_guard<std::mutex> lock(state_->mutex);
+        state_->tasks.emplace_back(std::forward<F>(f));
+        state_->pending++;
     }
-    condition_.notify_one();
-    return res;
+    state_->condition.notify_all();
+    // the handle keeps the state alive, it may run after the group has finished and is destroyed
+    pool_.Push([state = state_]() { RunNext(*state); });
 }
 } // namespace Restool
 } // namespace Global
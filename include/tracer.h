@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_RESTOOL_TRACER_H
+#define OHOS_RESTOOL_TRACER_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "singleton.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+/**
+ * Records spans and counters of a build and saves them in the Trace Event JSON format, which can be
+ * loaded by chrome://tracing or Perfetto. Each thread records to its own buffer, nothing is recorded
+ * until Start is called.
+ */
+class Tracer : public Singleton<Tracer> {
+public:
+    /**
+     * @brief start recording.
+     * @param path: path of the trace file written by Save.
+     */
+    void Start(const std::string &path);
+    bool IsEnabled() const;
+
+    /**
+     * @brief name the current thread in the trace.
+     * @param name: thread name.
+     */
+    void SetThreadName(const std::string &name);
+
+    /**
+     * @brief record a span of the current thread.
+     * @param name: span name.
+     * @param category: span category.
+     * @param start: start time, from GetTime.
+     * @param end: end time, from GetTime.
+     */
+    void AddSpan(const std::string &name, const char *category, int64_t start, int64_t end);
+
+    /**
+     * @brief record the value of a counter.
+     * @param name: counter name.
+     * @param value: counter value.
+     */
+    void AddCounter(const char *name, int64_t value);
+
+    /**
+     * @brief write the recorded events to the trace file, the events are kept for the next save.
+     * @return true if the trace file is written, other false.
+     */
+    bool Save() const;
+
+    /**
+     * @brief get the time since Start in microseconds.
+     */
+    int64_t GetTime() const;
+
+private:
+    struct Event {
+        char phase;
+        const char *category;
+        std::string name;
+        int64_t time;
+        int64_t value; // duration of a span or value of a counter
+    };
+    struct ThreadBuffer {
+        uint32_t tid;
+        std::string name;
+        std::mutex mutex;
+        std::vector<Event> events;
+    };
+    ThreadBuffer &GetThreadBuffer();
+    static void WriteEvent(std::string &out, const Event &event, uint32_t tid);
+    static std::string Escape(const std::string &str);
+
+    static thread_local ThreadBuffer *threadBuffer_;
+    std::atomic<bool> enabled_{ false };
+    std::string path_;
+    std::chrono::steady_clock::time_point startTime_;
+    mutable std::mutex buffersMutex_;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+};
+
+/**
+ * Records the lifetime of the object as a span, does nothing if the tracer is not started.
+ */
+class TraceScope {
+public:
+    explicit TraceScope(const char *name, const char *category = "phase");
+    TraceScope(const std::string &name, const char *category = "phase");
+    ~TraceScope();
+    TraceScope(const TraceScope &) = delete;
+    TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+    std::string name_;
+    const char *category_;
+    int64_t start_ = -1;
+};
+}
+}
+}
+#endif
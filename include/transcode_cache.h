@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_RESTOOL_TRANSCODE_CACHE_H
+#define OHOS_RESTOOL_TRANSCODE_CACHE_H
+
+#include <atomic>
+#include <string>
+#include "compression_parser.h"
+#include "singleton.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+/**
+ * Cache of transcoded images shared between builds. An entry is keyed by the source content, the transcode
+ * options and the transcoder library, and holds the transcoded file with its result. The least recently used
+ * entries are removed once the cache grows over its size limit.
+ */
+class TranscodeCache : public Singleton<TranscodeCache> {
+public:
+    /**
+     * @brief enable the cache, the cache is disabled if the directory can not be created.
+     * @param cacheDir: cache directory.
+     * @param libraryPath: path of the transcoder library, entries of other libraries are not used.
+     */
+    void Init(const std::string &cacheDir, const std::string &libraryPath);
+    bool IsEnabled() const;
+
+    /**
+     * @brief get the key of a transcode.
+     * @param src: source image path.
+     * @param options: transcode options.
+     * @param extAppend: whether the extension is appended to the output file name.
+     * @return key of the transcode, empty if the cache is disabled or the source can not be read.
+     */
+    std::string GetKey(const std::string &src, const std::string &options, bool extAppend) const;
+
+    /**
+     * @brief get a cached transcode, the cached file is copied to the output directory.
+     * @param key: key of the transcode.
+     * @param outputPath: output directory, set to the output file if the transcode succeeded.
+     * @param error: cached transcode error.
+     * @param result: cached transcode result.
+     * @return true if the transcode is cached, other false.
+     */
+    bool Get(const std::string &key, std::string &outputPath, TranscodeError &error, TranscodeResult &result);
+
+    /**
+     * @brief cache a transcode, a transcode that failed by an unexpected error is not cached.
+     * @param key: key of the transcode.
+     * @param outputDir: output directory passed to the transcoder.
+     * @param outputPath: output file of the transcoder.
+     * @param error: transcode error.
+     * @param result: transcode result.
+     * @param costTime: time of the transcode in microseconds.
+     */
+    void Put(const std::string &key, const std::string &outputDir, const std::string &outputPath,
+        TranscodeError error, const TranscodeResult &result, unsigned long long costTime);
+
+    /**
+     * @brief remove the least recently used entries until the cache is under its size limit.
+     */
+    void Trim() const;
+
+    /**
+     * @brief get the hits, misses and saved time of this build.
+     * @return message of the statistics, empty if the cache is disabled.
+     */
+    std::string GetStatistics() const;
+
+private:
+    struct Entry {
+        TranscodeError error = TranscodeError::SUCCESS;
+        std::string filename;
+        TranscodeResult result = { 0, 0, 0, 0 };
+        unsigned long long costTime = 0;
+    };
+    bool ReadEntry(const std::string &key, Entry &entry) const;
+    std::string GetEntryPath(const std::string &key, const std::string &extension) const;
+    static bool GetHash(const std::string &path, uint64_t &hash);
+    static bool IsCacheable(TranscodeError error);
+    static void Touch(const std::string &path);
+
+    std::string cacheDir_;
+    uint64_t libraryHash_ = 0;
+    bool enabled_ = false;
+    std::atomic<uint64_t> hits_{ 0 };
+    std::atomic<uint64_t> misses_{ 0 };
+    std::atomic<unsigned long long> savedTime_{ 0 };
+    static constexpr uint64_t MAX_CACHE_SIZE = 2ULL * 1024 * 1024 * 1024;
+};
+}
+}
+}
+#endif
@@ -27,9 +27,8 @@ AppendCompiler::AppendCompiler(ResType type, const string &output) : IResourceCo
 
 uint32_t AppendCompiler::CompileSingleFile(const FileInfo &fileInfo)
 {
-    ResourceItem resourceItem(fileInfo.filename, fileInfo.keyParams, type_);
+    ResourceItem resourceItem(fileInfo.filename, fileInfo.limitKey, fileInfo.keyParams, type_);
     resourceItem.SetFilePath(fileInfo.filePath);
-    resourceItem.SetLimitKey(fileInfo.limitKey);
 
     string data = fileInfo.filePath;
     if (!resourceItem.SetData(reinterpret_cast<const int8_t *>(data.c_str()), data.length())) {
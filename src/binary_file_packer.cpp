@@ -15,8 +15,11 @@
 
 #include "binary_file_packer.h"
 
+#include "build_state.h"
 #include "compression_parser.h"
 #include "restool_errors.h"
+#include "sharded_set.h"
+#include "tracer.h"
 
 namespace OHOS {
 namespace Global {
@@ -41,6 +44,7 @@ void BinaryFilePacker::Terminate()
 uint32_t BinaryFilePacker::GetResult()
 {
     if (copyFuture_.valid()) {
+        ThreadPool::GetInstance().Wait(copyFuture_);
         result_ = copyFuture_.get();
     }
     return result_;
@@ -65,6 +69,7 @@ uint32_t BinaryFilePacker::CopyBinaryFile(const vector<string> &inputs)
 
 uint32_t BinaryFilePacker::CopyBinaryFile(const string &input)
 {
+    TraceScope scope("CopyBinaryFile " + input);
     string rawfilePath = FileEntry::FilePath(input).Append(RAW_FILE_DIR).GetPath();
     if (CopyBinaryFile(rawfilePath, RAW_FILE_DIR) == RESTOOL_ERROR) {
         return RESTOOL_ERROR;
@@ -131,19 +136,15 @@ uint32_t BinaryFilePacker::CopyBinaryFileImpl(const string &src, const string &d
         }
 
         string path = entry->GetFilePath().GetPath();
-        auto copyFunc = [this](const string path, string subPath) { return this->CopySingleFile(path, subPath); };
-        std::future<uint32_t> res = ThreadPool::GetInstance().Enqueue(copyFunc, path, subPath);
-        copyResults_.push_back(std::move(res));
+        copyTasks_.Run([this, path, subPath]() mutable { return this->CopySingleFile(path, subPath); });
     }
     return RESTOOL_SUCCESS;
 }
 
 bool BinaryFilePacker::IsDuplicated(const unique_ptr<FileEntry> &entry, string subPath)
 {
-    lock_guard<mutex> lock(mutex_);
-    if (g_hapResourceSet.count(subPath)) {
-        g_hapResourceSet.erase(subPath);
-    } else if (!g_resourceSet.emplace(subPath).second) {
+    ShardedSet::Key key = ShardedSet::MakeKey(move(subPath));
+    if (!g_hapResourceSet.Erase(key) && !g_resourceSet.Insert(key)) {
         cout << "Warning: '" << entry->GetFilePath().GetPath() << "' is defined repeatedly." << endl;
         return true;
     }
@@ -156,31 +157,35 @@ uint32_t BinaryFilePacker::CopySingleFile(const std::string &path, std::string &
         cout << "Info: CopySingleFile: stop copy binary file." << endl;
         return RESTOOL_ERROR;
     }
+    BuildState &buildState = BuildState::GetInstance();
+    string output;
+    if (buildState.GetOutput(path, output)) {
+        return RESTOOL_SUCCESS;
+    }
     if (moduleName_ == "har" || CompressionParser::GetCompressionParser()->GetDefaultCompress()) {
         if (!ResourceUtil::CopyFileInner(path, subPath)) {
             return RESTOOL_ERROR;
         }
+        buildState.SetOutput(path, subPath);
         return RESTOOL_SUCCESS;
     }
-    if (!CompressionParser::GetCompressionParser()->CopyAndTranscode(path, subPath, true)) {
+    string cache;
+    if (!CompressionParser::GetCompressionParser()->CopyAndTranscode(path, subPath, cache, true)) {
         return RESTOOL_ERROR;
     }
+    buildState.SetOutput(path, subPath, cache);
     return RESTOOL_SUCCESS;
 }
 
 uint32_t BinaryFilePacker::CheckCopyResults()
 {
-    for (auto &res : copyResults_) {
-        if (terminate_.load()) {
-            cout << "Info: CopyBinaryFile: stop copy binary file." << endl;
-            return RESTOOL_ERROR;
-        }
-        uint32_t ret = res.get();
-        if (ret != RESTOOL_SUCCESS) {
-            return RESTOOL_ERROR;
-        }
+    // runs the queued copies while waiting, so it may be called from a pool task with any thread count
+    uint32_t ret = copyTasks_.Wait();
+    if (terminate_.load()) {
+        cout << "Info: CopyBinaryFile: stop copy binary file." << endl;
+        return RESTOOL_ERROR;
     }
-    return RESTOOL_SUCCESS;
+    return ret;
 }
 } // namespace Restool
 } // namespace Global
@@ -0,0 +1,453 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "build_state.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sys/stat.h>
+#include "file_entry.h"
+#include "output_sink.h"
+#include "resource_util.h"
+#include "restool_errors.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+using namespace std;
+namespace {
+const string BUILD_STATE_FILE = ".restool_build_state";
+const char STATE_TAG[TAG_LEN] = {'R', 'S', 'B', 'S'};
+constexpr uint32_t STATE_VERSION = 2; // 2: the first output is the file in the resources, not in the caches
+constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+constexpr int64_t NANOSECONDS_PER_SECOND = 1000000000;
+constexpr size_t HASH_BUFFER_SIZE = 64 * 1024;
+
+class StateReader {
+public:
+    StateReader(const char *data, size_t length) : data_(data), length_(length) {}
+
+    template<typename T>
+    bool Read(T &value)
+    {
+        if (length_ - pos_ < sizeof(T)) {
+            return false;
+        }
+        memcpy(&value, data_ + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return true;
+    }
+
+    bool Read(string &value)
+    {
+        uint32_t size = 0;
+        if (!Read(size) || length_ - pos_ < size) {
+            return false;
+        }
+        value.assign(data_ + pos_, size);
+        pos_ += size;
+        return true;
+    }
+
+    bool IsEnd() const
+    {
+        return pos_ == length_;
+    }
+
+private:
+    const char *data_;
+    size_t length_;
+    size_t pos_ = 0;
+};
+
+template<typename T>
+void Write(string &buffer, const T &value)
+{
+    buffer.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+void Write(string &buffer, const string &value)
+{
+    Write(buffer, static_cast<uint32_t>(value.size()));
+    buffer.append(value);
+}
+
+bool ReadItem(StateReader &reader, ResourceItem &item)
+{
+    string name;
+    string limitKey;
+    string filePath;
+    int32_t type = 0;
+    uint32_t keyCount = 0;
+    if (!reader.Read(name) || !reader.Read(limitKey) || !reader.Read(filePath) || !reader.Read(type) ||
+        !reader.Read(keyCount)) {
+        return false;
+    }
+    vector<KeyParam> keyParams;
+    for (uint32_t i = 0; i < keyCount; i++) {
+        int32_t keyType = 0;
+        KeyParam keyParam;
+        if (!reader.Read(keyType) || !reader.Read(keyParam.value)) {
+            return false;
+        }
+        keyParam.keyType = static_cast<KeyType>(keyType);
+        keyParams.push_back(keyParam);
+    }
+    string data;
+    if (!reader.Read(data)) {
+        return false;
+    }
+    item = ResourceItem(name, limitKey, keyParams, static_cast<ResType>(type));
+    item.SetFilePath(filePath);
+    return item.SetData(reinterpret_cast<const int8_t *>(data.c_str()), data.length());
+}
+
+void WriteItem(string &buffer, const ResourceItem &item)
+{
+    Write(buffer, item.GetName());
+    Write(buffer, item.GetLimitKey());
+    Write(buffer, item.GetFilePath());
+    Write(buffer, static_cast<int32_t>(item.GetResType()));
+    Write(buffer, static_cast<uint32_t>(item.GetKeyParam().size()));
+    for (const auto &keyParam : item.GetKeyParam()) {
+        Write(buffer, static_cast<int32_t>(keyParam.keyType));
+        Write(buffer, keyParam.value);
+    }
+    Write(buffer, string(reinterpret_cast<const char *>(item.GetData()), item.GetDataLength()));
+}
+}
+
+void BuildState::Load(const string &output, const string &options, const vector<string> &dependencies)
+{
+    enabled_ = true;
+    statePath_ = FileEntry::FilePath(output).Append(BUILD_STATE_FILE).GetPath();
+    options_ = options + GetDependencyKey(dependencies);
+    ifstream in(FileEntry::AdaptLongPath(statePath_), ios::binary);
+    if (!in.is_open()) {
+        cout << "Info: incremental build: no build state in '" << output << "', build all resources." << endl;
+        return;
+    }
+    string buffer((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    in.close();
+    if (!Parse(buffer.c_str(), buffer.size())) {
+        cout << "Warning: incremental build: invalid build state '" << statePath_ << "', build all resources."
+            << endl;
+        last_.clear();
+        ids_.clear();
+    }
+    // the outputs are rewritten from now on, the state is trusted again only after this build succeeds
+    ResourceUtil::RmoveFile(statePath_);
+}
+
+uint32_t BuildState::Save()
+{
+    if (!enabled_) {
+        return RESTOOL_SUCCESS;
+    }
+    set<string> outputs;
+    for (const auto &entry : current_) {
+        outputs.insert(entry.second.outputs.begin(), entry.second.outputs.end());
+    }
+    for (const auto &entry : last_) {
+        for (const auto &output : entry.second.outputs) {
+            if (outputs.count(output) == 0 && ResourceUtil::FileExist(output) && !ResourceUtil::RmoveFile(output)) {
+                return RESTOOL_ERROR;
+            }
+        }
+    }
+
+    string buffer;
+    Serialize(buffer);
+    ofstream out(FileEntry::AdaptLongPath(statePath_), ofstream::out | ofstream::binary);
+    if (!out.is_open()) {
+        PrintError(GetError(ERR_CODE_OPEN_FILE_ERROR).FormatCause(statePath_.c_str(), strerror(errno)));
+        return RESTOOL_ERROR;
+    }
+    out.write(buffer.c_str(), buffer.size());
+    if (!out.good()) {
+        PrintError(GetError(ERR_CODE_CREATE_FILE_ERROR).FormatCause(statePath_.c_str(), strerror(errno)));
+        return RESTOOL_ERROR;
+    }
+    cout << "Info: incremental build: " << reused_ << " of " << current_.size() << " inputs are unchanged." << endl;
+    return RESTOOL_SUCCESS;
+}
+
+bool BuildState::IsEnabled() const
+{
+    return enabled_;
+}
+
+bool BuildState::HasLastState() const
+{
+    return hasLastState_;
+}
+
+bool BuildState::GetItems(const string &input, vector<ResourceItem> &items)
+{
+    Fingerprint fingerprint;
+    const Entry *last = FindUnchanged(input, fingerprint);
+    if (!last || last->items.empty()) {
+        return false;
+    }
+    items = last->items;
+    Entry entry;
+    entry.fingerprint = fingerprint;
+    entry.items = last->items;
+    Record(input, std::move(entry), true);
+    return true;
+}
+
+void BuildState::SetItems(const string &input, const vector<ResourceItem> &items)
+{
+    Entry entry;
+    if (!enabled_ || !GetFingerprint(input, entry.fingerprint)) {
+        return;
+    }
+    entry.items = items;
+    Record(input, std::move(entry), false);
+}
+
+bool BuildState::GetOutput(const string &input, string &output)
+{
+    Fingerprint fingerprint;
+    const Entry *last = FindUnchanged(input, fingerprint);
+    if (!last || last->outputs.empty() || !ResourceUtil::FileExist(last->outputs.front())) {
+        return false;
+    }
+    // the output is reused without being written, it is still an output of this build
+    output = last->outputs.front();
+    OutputSink::GetInstance().Keep(output);
+    Entry entry;
+    entry.fingerprint = fingerprint;
+    entry.outputs = last->outputs;
+    Record(input, std::move(entry), true);
+    return true;
+}
+
+void BuildState::SetOutput(const string &input, const string &output, const string &cache)
+{
+    Entry entry;
+    if (!enabled_ || !GetFingerprint(input, entry.fingerprint)) {
+        return;
+    }
+    entry.outputs.push_back(output);
+    if (!cache.empty()) {
+        entry.outputs.push_back(cache);
+    }
+    Record(input, std::move(entry), false);
+}
+
+const map<pair<ResType, string>, int64_t> &BuildState::GetIds() const
+{
+    return ids_;
+}
+
+void BuildState::SetIds(const map<pair<ResType, string>, int64_t> &ids)
+{
+    ids_ = ids;
+}
+
+// below private
+const BuildState::Entry *BuildState::FindUnchanged(const string &input, Fingerprint &fingerprint) const
+{
+    // last_ is not modified after Load, so it is read without lock
+    if (!hasLastState_) {
+        return nullptr;
+    }
+    auto it = last_.find(input);
+    if (it == last_.end()) {
+        return nullptr;
+    }
+    const Fingerprint &last = it->second.fingerprint;
+    if (!GetStat(input, fingerprint) || fingerprint.size != last.size) {
+        return nullptr;
+    }
+    if (fingerprint.mtime == last.mtime) {
+        fingerprint.hash = last.hash;
+        return &it->second;
+    }
+    // touched but maybe not modified
+    if (!GetHash(input, fingerprint.hash) || fingerprint.hash != last.hash) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+void BuildState::Record(const string &input, Entry &&entry, bool reused)
+{
+    lock_guard<mutex> lock(mutex_);
+    current_[input] = std::move(entry);
+    if (reused) {
+        reused_++;
+    }
+}
+
+bool BuildState::Parse(const char *data, size_t length)
+{
+    StateReader reader(data, length);
+    char tag[TAG_LEN];
+    uint32_t version = 0;
+    string options;
+    if (!reader.Read(tag) || memcmp(tag, STATE_TAG, TAG_LEN) != 0 || !reader.Read(version) ||
+        !reader.Read(options)) {
+        return false;
+    }
+    if (version != STATE_VERSION || options != options_) {
+        cout << "Info: incremental build: options changed since the last build, build all resources." << endl;
+        return true;
+    }
+    uint32_t count = 0;
+    if (!reader.Read(count)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        string input;
+        Entry entry;
+        uint32_t outputCount = 0;
+        if (!reader.Read(input) || !reader.Read(entry.fingerprint.size) || !reader.Read(entry.fingerprint.mtime) ||
+            !reader.Read(entry.fingerprint.hash) || !reader.Read(outputCount)) {
+            return false;
+        }
+        entry.outputs.resize(outputCount);
+        for (auto &output : entry.outputs) {
+            if (!reader.Read(output)) {
+                return false;
+            }
+        }
+        uint32_t itemCount = 0;
+        if (!reader.Read(itemCount)) {
+            return false;
+        }
+        entry.items.resize(itemCount);
+        for (auto &item : entry.items) {
+            if (!ReadItem(reader, item)) {
+                return false;
+            }
+        }
+        last_.emplace(input, std::move(entry));
+    }
+    if (!reader.Read(count)) {
+        return false;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        int32_t type = 0;
+        string name;
+        int64_t id = 0;
+        if (!reader.Read(type) || !reader.Read(name) || !reader.Read(id)) {
+            return false;
+        }
+        ids_.emplace(make_pair(static_cast<ResType>(type), name), id);
+    }
+    if (!reader.IsEnd()) {
+        return false;
+    }
+    hasLastState_ = true;
+    return true;
+}
+
+void BuildState::Serialize(string &buffer) const
+{
+    buffer.append(STATE_TAG, TAG_LEN);
+    Write(buffer, STATE_VERSION);
+    Write(buffer, options_);
+    Write(buffer, static_cast<uint32_t>(current_.size()));
+    for (const auto &[input, entry] : current_) {
+        Write(buffer, input);
+        Write(buffer, entry.fingerprint.size);
+        Write(buffer, entry.fingerprint.mtime);
+        Write(buffer, entry.fingerprint.hash);
+        Write(buffer, static_cast<uint32_t>(entry.outputs.size()));
+        for (const auto &output : entry.outputs) {
+            Write(buffer, output);
+        }
+        Write(buffer, static_cast<uint32_t>(entry.items.size()));
+        for (const auto &item : entry.items) {
+            WriteItem(buffer, item);
+        }
+    }
+    Write(buffer, static_cast<uint32_t>(ids_.size()));
+    for (const auto &[key, id] : ids_) {
+        Write(buffer, static_cast<int32_t>(key.first));
+        Write(buffer, key.second);
+        Write(buffer, id);
+    }
+}
+
+string BuildState::GetDependencyKey(const vector<string> &dependencies) const
+{
+    string key;
+    for (const auto &dependency : dependencies) {
+        Fingerprint fingerprint;
+        key.append("|").append(dependency).append(":");
+        if (GetFingerprint(dependency, fingerprint)) {
+            key.append(to_string(fingerprint.size)).append(":").append(to_string(fingerprint.hash));
+        }
+    }
+    return key;
+}
+
+bool BuildState::GetStat(const string &path, Fingerprint &fingerprint)
+{
+#ifdef _WIN32
+    struct _stat64 s;
+    if (_stat64(FileEntry::AdaptLongPath(path).c_str(), &s) != 0) {
+        return false;
+    }
+    fingerprint.mtime = static_cast<int64_t>(s.st_mtime) * NANOSECONDS_PER_SECOND;
+#else
+    struct stat s;
+    if (stat(path.c_str(), &s) != 0) {
+        return false;
+    }
+#ifdef __APPLE__
+    fingerprint.mtime = static_cast<int64_t>(s.st_mtimespec.tv_sec) * NANOSECONDS_PER_SECOND +
+        s.st_mtimespec.tv_nsec;
+#else
+    fingerprint.mtime = static_cast<int64_t>(s.st_mtim.tv_sec) * NANOSECONDS_PER_SECOND + s.st_mtim.tv_nsec;
+#endif
+#endif
+    fingerprint.size = static_cast<uint64_t>(s.st_size);
+    return true;
+}
+
+bool BuildState::GetHash(const string &path, uint64_t &hash)
+{
+    ifstream in(FileEntry::AdaptLongPath(path), ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    // FNV-1a, only used to tell a touched file from a modified one
+    hash = FNV_OFFSET_BASIS;
+    vector<char> buffer(HASH_BUFFER_SIZE);
+    while (in) {
+        in.read(buffer.data(), buffer.size());
+        streamsize count = in.gcount();
+        for (streamsize i = 0; i < count; i++) {
+            hash ^= static_cast<uint8_t>(buffer[i]);
+            hash *= FNV_PRIME;
+        }
+    }
+    return in.eof();
+}
+
+bool BuildState::GetFingerprint(const string &path, Fingerprint &fingerprint)
+{
+    return GetStat(path, fingerprint) && GetHash(path, fingerprint.hash);
+}
+}
+}
+}
@@ -116,6 +116,9 @@ void CmdParser::ShowUseage()
     std::cout << "    --ignored-file      Regular patterns of ignored files, split by ':'(like \\.git:\\.svn).\n";
     std::cout << "    --ignored-path      Regular patterns of ignored file paths, split by ':'";
     std::cout << "(like .+/rawfile/\\.git:.+/resfile/\\.svn).\n";
+    std::cout << "    --incremental       Reuse the unchanged resources of the last build in the output path.\n";
+    std::cout << "    --transcode-cache   Directory of the transcoded images cache shared between builds.\n";
+    std::cout << "    --trace             Save the build trace to the file, in the Trace Event JSON format.\n";
 }
 }
 }
@@ -54,6 +54,9 @@ const struct option PackageParser::CMD_OPTS[] = {
     { "thread", required_argument, nullptr, Option::THREAD},
     { "ignored-file", required_argument, nullptr, Option::IGNORED_FILE},
     { "ignored-path", required_argument, nullptr, Option::IGNORED_PATH},
+    { "incremental", no_argument, nullptr, Option::INCREMENTAL},
+    { "transcode-cache", required_argument, nullptr, Option::TRANSCODE_CACHE},
+    { "trace", required_argument, nullptr, Option::TRACE},
     { 0, 0, 0, 0},
 };
 
@@ -491,6 +494,17 @@ size_t PackageParser::GetThreadCount() const
     return threadCount_;
 }
 
+uint32_t PackageParser::SetIncremental()
+{
+    isIncremental_ = true;
+    return RESTOOL_SUCCESS;
+}
+
+bool PackageParser::IsIncremental() const
+{
+    return isIncremental_;
+}
+
 bool PackageParser::IsAscii(const string& argValue) const
 {
 #ifdef __WIN32
@@ -523,6 +537,36 @@ const std::string &PackageParser::GetCompressionPath() const
     return compressionPath_;
 }
 
+uint32_t PackageParser::SetTranscodeCachePath(const std::string &argValue)
+{
+    if (argValue.empty()) {
+        PrintError(GetError(ERR_CODE_INVALID_ARGUMENT).FormatCause("--transcode-cache"));
+        return RESTOOL_ERROR;
+    }
+    transcodeCachePath_ = argValue;
+    return RESTOOL_SUCCESS;
+}
+
+const std::string &PackageParser::GetTranscodeCachePath() const
+{
+    return transcodeCachePath_;
+}
+
+uint32_t PackageParser::SetTracePath(const std::string &argValue)
+{
+    if (argValue.empty()) {
+        PrintError(GetError(ERR_CODE_INVALID_ARGUMENT).FormatCause("--trace"));
+        return RESTOOL_ERROR;
+    }
+    tracePath_ = argValue;
+    return RESTOOL_SUCCESS;
+}
+
+const std::string &PackageParser::GetTracePath() const
+{
+    return tracePath_;
+}
+
 bool PackageParser::IsOverlap() const
 {
     return isOverlap_;
@@ -553,6 +597,9 @@ void PackageParser::InitCommand()
     handles_.emplace(Option::THREAD, bind(&PackageParser::ParseThread, this, _1));
     handles_.emplace(Option::IGNORED_FILE, bind(&PackageParser::ParseIgnoreRegex, this, _1, "--ignored-file"));
     handles_.emplace(Option::IGNORED_PATH, bind(&PackageParser::ParseIgnoreRegex, this, _1, "--ignored-path"));
+    handles_.emplace(Option::INCREMENTAL, [this](const string &) -> uint32_t { return SetIncremental(); });
+    handles_.emplace(Option::TRANSCODE_CACHE, bind(&PackageParser::SetTranscodeCachePath, this, _1));
+    handles_.emplace(Option::TRACE, bind(&PackageParser::SetTracePath, this, _1));
 }
 
 uint32_t PackageParser::HandleProcess(int c, const string &argValue)
@@ -16,9 +16,11 @@
 #include "compression_parser.h"
 
 #include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <mutex>
 #include "restool_errors.h"
+#include "transcode_cache.h"
 
 namespace OHOS {
 namespace Global {
@@ -26,6 +28,7 @@ namespace Restool {
 using namespace std;
 static shared_ptr<CompressionParser> compressionParseMgr = nullptr;
 static once_flag compressionParserMgrFlag;
+static atomic<uint64_t> g_instanceCount(0);
 
 const map<TranscodeError, string> ERRORCODEMAP = {
     { TranscodeError::SUCCESS, "SUCCESS" },
@@ -42,13 +45,14 @@ const map<TranscodeError, string> ERRORCODEMAP = {
 };
 
 CompressionParser::CompressionParser()
-    : filePath_(""), extensionPath_(""), mediaSwitch_(false), root_(nullptr), defaultCompress_(false), outPath_("")
+    : filePath_(""), extensionPath_(""), mediaSwitch_(false), root_(nullptr), defaultCompress_(false), outPath_(""),
+    instanceId_(++g_instanceCount)
 {
 }
 
 CompressionParser::CompressionParser(const string &filePath)
     : filePath_(filePath), extensionPath_(""), mediaSwitch_(false), root_(nullptr), defaultCompress_(false),
-    outPath_("")
+    outPath_(""), instanceId_(++g_instanceCount)
 {
 }
 
@@ -100,6 +104,7 @@ uint32_t CompressionParser::Init()
     if (!LoadImageTranscoder()) {
         return RESTOOL_ERROR;
     }
+    TranscodeCache::GetInstance().Init(cachePath_, extensionPath_);
     cJSON *compressionNode = cJSON_GetObjectItem(root_, "compression");
     if (!ParseCompression(compressionNode)) {
         return RESTOOL_ERROR;
@@ -237,6 +242,11 @@ bool CompressionParser::IsDefaultCompress()
     return pathEmpty && excludePathEmpty && (compressFilter->rules.empty()) && (compressFilter->excludeRules.empty());
 }
 
+void CompressionParser::SetCachePath(const string &path)
+{
+    cachePath_ = path;
+}
+
 void CompressionParser::SetOutPath(const string &path)
 {
     outPath_ = path;
@@ -373,18 +383,50 @@ TranscodeError CompressionParser::TranscodeImages(const string &imagePath, const
     }
     TranscodeError ret = (*iTranscodeImages)(imagePath, extAppend, outputPath, result);
     if (ret != TranscodeError::SUCCESS) {
-        auto iter = ERRORCODEMAP.find(ret);
-        if (iter != ERRORCODEMAP.end()) {
-            cout << "Warning: TranscodeImages failed, error message: " << iter->second << ", file path = " <<
-                imagePath << endl;
-        } else {
-            cout << "Warning: TranscodeImages failed" << ", file path = " << imagePath << endl;
-        }
+        PrintTranscodeWarning(ret, imagePath);
         return ret;
     }
     return TranscodeError::SUCCESS;
 }
 
+void CompressionParser::PrintTranscodeWarning(TranscodeError ret, const string &imagePath)
+{
+    auto iter = ERRORCODEMAP.find(ret);
+    if (iter != ERRORCODEMAP.end()) {
+        cout << "Warning: TranscodeImages failed, error message: " << iter->second << ", file path = " <<
+            imagePath << endl;
+    } else {
+        cout << "Warning: TranscodeImages failed" << ", file path = " << imagePath << endl;
+    }
+}
+
+bool CompressionParser::Transcode(const string &src, const string &optionJson, const string &optionJsonExclude,
+    const bool extAppend, string &output, TranscodeResult &result, TranscodeError &res)
+{
+    TranscodeCache &cache = TranscodeCache::GetInstance();
+    string key = cache.GetKey(src, optionJson + "\n" + optionJsonExclude, extAppend);
+    if (!key.empty() && cache.Get(key, output, res, result)) {
+        if (res != TranscodeError::SUCCESS) {
+            PrintTranscodeWarning(res, src);
+        }
+        return true;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    if (!AcquireOptions(optionJson, optionJsonExclude)) {
+        return false;
+    }
+    string outputDir = output;
+    res = TranscodeImages(src, extAppend, output, result);
+    ReleaseOptions();
+    if (!key.empty()) {
+        unsigned long long costTime = static_cast<unsigned long long>(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+        cache.Put(key, outputDir, output, res, result, costTime);
+    }
+    return true;
+}
+
 TranscodeError CompressionParser::ScaleImage(const std::string &imagePath, std::string &outputPath)
 {
     if (!handle_) {
@@ -458,13 +500,75 @@ string CompressionParser::GetFileRules(const string &rules, const string &method
     return res.append(method).append(",").append(rules).append("}");
 }
 
-void CompressionParser::CollectTime(uint32_t &count, unsigned long long &time,
-    std::chrono::time_point<std::chrono::steady_clock> &start)
+bool CompressionParser::AcquireOptions(const string &optionJson, const string &optionJsonExclude)
+{
+    unique_lock<mutex> lock(optionsMutex_);
+    auto isCurrent = [this, &optionJson, &optionJsonExclude]() {
+        return hasOptions_ && optionJson_ == optionJson && optionJsonExclude_ == optionJsonExclude;
+    };
+    // the options are only switched when no transcode runs, and the current options stop taking new
+    // transcodes while other options are waiting, so that they are not starved
+    auto canRun = [this, &isCurrent]() {
+        if (activeTranscodes_ == 0) {
+            return true;
+        }
+        auto current = waitingOptions_.find(make_pair(optionJson_, optionJsonExclude_));
+        uint32_t waitingCurrent = current == waitingOptions_.end() ? 0 : current->second;
+        return isCurrent() && waitingCurrent == waitingCount_;
+    };
+    if (!canRun()) {
+        auto key = make_pair(optionJson, optionJsonExclude);
+        waitingOptions_[key]++;
+        waitingCount_++;
+        optionsCondition_.wait(lock, canRun);
+        waitingCount_--;
+        if (--waitingOptions_[key] == 0) {
+            waitingOptions_.erase(key);
+        }
+    }
+    if (!isCurrent()) {
+        hasOptions_ = SetTranscodeOptions(optionJson, optionJsonExclude);
+        if (!hasOptions_) {
+            optionsCondition_.notify_all();
+            return false;
+        }
+        optionJson_ = optionJson;
+        optionJsonExclude_ = optionJsonExclude;
+        optionsCondition_.notify_all();
+    }
+    activeTranscodes_++;
+    return true;
+}
+
+void CompressionParser::ReleaseOptions()
+{
+    lock_guard<mutex> lock(optionsMutex_);
+    activeTranscodes_--;
+    if (activeTranscodes_ == 0) {
+        optionsCondition_.notify_all();
+    }
+}
+
+CompressionParser::TranscodeStatistics &CompressionParser::GetStatistics()
+{
+    thread_local TranscodeStatistics *statistics = nullptr;
+    thread_local uint64_t owner = 0;
+    if (statistics == nullptr || owner != instanceId_) {
+        lock_guard<mutex> lock(statisticsMutex_);
+        statistics_.push_back(make_unique<TranscodeStatistics>());
+        statistics = statistics_.back().get();
+        owner = instanceId_;
+    }
+    return *statistics;
+}
+
+void CompressionParser::CollectTime(std::chrono::time_point<std::chrono::steady_clock> &start)
 {
     unsigned long long costTime = static_cast<unsigned long long>(
         std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
-    time += costTime;
-    count++;
+    TranscodeStatistics &statistics = GetStatistics();
+    statistics.totalTime += costTime;
+    statistics.totalCounts++;
 }
 
 void CompressionParser::CollectTimeAndSize(TranscodeError res,
@@ -472,33 +576,53 @@ void CompressionParser::CollectTimeAndSize(TranscodeError res,
 {
     unsigned long long costTime = static_cast<unsigned long long>(
         std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+    TranscodeStatistics &statistics = GetStatistics();
     if (res == TranscodeError::SUCCESS) {
-        totalTime_ += costTime;
-        totalCounts_++;
-        compressTime_ += costTime;
-        compressCounts_++;
-        successTime_ += costTime;
-        successCounts_++;
-        originalSize_ += result.originSize;
-        successSize_ += static_cast<unsigned long long>(result.size);
+        statistics.totalTime += costTime;
+        statistics.totalCounts++;
+        statistics.compressTime += costTime;
+        statistics.compressCounts++;
+        statistics.successTime += costTime;
+        statistics.successCounts++;
+        statistics.originalSize += result.originSize;
+        statistics.successSize += static_cast<unsigned long long>(result.size);
     } else if (res < TranscodeError::NOT_MATCH_BASE) {
-        totalTime_ += costTime;
-        compressTime_ += costTime;
-        compressCounts_++;
+        statistics.totalTime += costTime;
+        statistics.compressTime += costTime;
+        statistics.compressCounts++;
     } else {
-        totalTime_ += costTime;
+        statistics.totalTime += costTime;
     }
 }
 
 string CompressionParser::PrintTransMessage()
 {
+    TranscodeStatistics total;
+    {
+        lock_guard<mutex> lock(statisticsMutex_);
+        for (const auto &statistics : statistics_) {
+            total.totalTime += statistics->totalTime;
+            total.totalCounts += statistics->totalCounts;
+            total.compressTime += statistics->compressTime;
+            total.compressCounts += statistics->compressCounts;
+            total.successTime += statistics->successTime;
+            total.successCounts += statistics->successCounts;
+            total.originalSize += statistics->originalSize;
+            total.successSize += statistics->successSize;
+        }
+    }
     string res = "Processing report:\n";
-    res.append("total:").append(to_string(totalCounts_)).append(", ").append(to_string(totalTime_)).append(" us.\n");
-    res.append("compressed:").append(to_string(compressCounts_)).append(", ").append(to_string(compressTime_))
+    res.append("total:").append(to_string(total.totalCounts)).append(", ").append(to_string(total.totalTime))
         .append(" us.\n");
-    res.append("success:").append(to_string(successCounts_)).append(", ").append(to_string(successTime_))
-        .append(" us, ").append(to_string(originalSize_)).append(" Bytes to ").append(to_string(successSize_))
-        .append(" Bytes.");
+    res.append("compressed:").append(to_string(total.compressCounts)).append(", ")
+        .append(to_string(total.compressTime)).append(" us.\n");
+    res.append("success:").append(to_string(total.successCounts)).append(", ").append(to_string(total.successTime))
+        .append(" us, ").append(to_string(total.originalSize)).append(" Bytes to ")
+        .append(to_string(total.successSize)).append(" Bytes.");
+    string cacheStatistics = TranscodeCache::GetInstance().GetStatistics();
+    if (!cacheStatistics.empty()) {
+        res.append("\n").append(cacheStatistics);
+    }
     return res;
 }
 
@@ -517,37 +641,23 @@ bool CompressionParser::CheckAndTranscode(const string &src, string &dst, string
 {
     auto t1 = std::chrono::steady_clock::now();
     TranscodeResult result = {0, 0, 0, 0};
+    string optionJson;
+    string optionJsonExclude;
     if (defaultCompress_) {
-        if (!SetTranscodeOptions(GetMethod(compressFilter), "")) {
-            return false;
-        }
-        auto res = TranscodeImages(src, extAppend, output, result);
-        CollectTimeAndSize(res, t1, result);
-        if (res != TranscodeError::SUCCESS) {
-            return false;
-        }
-        dst = output;
-        return true;
-    }
-    if (!IsInPath(src, compressFilter)) {
-        return false;
-    }
-    if (IsInExcludePath(src, compressFilter)) {
-        if (!SetTranscodeOptions(GetRules(compressFilter), GetExcludeRules(compressFilter))) {
+        optionJson = GetMethod(compressFilter);
+    } else {
+        if (!IsInPath(src, compressFilter)) {
             return false;
         }
-        auto res = TranscodeImages(src, extAppend, output, result);
-        CollectTimeAndSize(res, t1, result);
-        if (res != TranscodeError::SUCCESS) {
-            return false;
+        optionJson = GetRules(compressFilter);
+        if (IsInExcludePath(src, compressFilter)) {
+            optionJsonExclude = GetExcludeRules(compressFilter);
         }
-        dst = output;
-        return true;
     }
-    if (!SetTranscodeOptions(GetRules(compressFilter), "")) {
+    TranscodeError res = TranscodeError::SUCCESS;
+    if (!Transcode(src, optionJson, optionJsonExclude, extAppend, output, result, res)) {
         return false;
     }
-    auto res = TranscodeImages(src, extAppend, output, result);
     CollectTimeAndSize(res, t1, result);
     if (res != TranscodeError::SUCCESS) {
         return false;
@@ -556,7 +666,7 @@ bool CompressionParser::CheckAndTranscode(const string &src, string &dst, string
     return true;
 }
 
-bool CompressionParser::CopyForTrans(const string &src, const string &originDst, const string &dst)
+bool CompressionParser::CopyForTrans(const string &src, const string &dst, string &output)
 {
     string srcSuffix;
     string dstSuffix;
@@ -566,23 +676,28 @@ bool CompressionParser::CopyForTrans(const string &src, const string &originDst,
         srcSuffix = src.substr(srcIndex + 1);
         dstSuffix = dst.substr(dstIndex + 1);
     }
-    auto ret = false;
     if (srcSuffix == dstSuffix) {
-        ret = ResourceUtil::CopyFileInner(src, dst);
-    } else {
-        uint32_t startIndex = outPath_.size() + CACHES_DIR.size() + 1;
-        string dstPath = outPath_ + SEPARATOR_FILE + RESOURCES_DIR + dst.substr(startIndex);
-        ret = ResourceUtil::CopyFileInner(dst, dstPath);
+        output = dst;
+        return ResourceUtil::CopyFileInner(src, dst);
     }
-    return ret;
+    uint32_t startIndex = outPath_.size() + CACHES_DIR.size() + 1;
+    output = outPath_ + SEPARATOR_FILE + RESOURCES_DIR + dst.substr(startIndex);
+    return ResourceUtil::CopyFileInner(dst, output);
 }
 
 bool CompressionParser::CopyAndTranscode(const string &src, string &dst, const bool extAppend)
 {
+    string cache;
+    return CopyAndTranscode(src, dst, cache, extAppend);
+}
+
+bool CompressionParser::CopyAndTranscode(const string &src, string &dst, string &cache, const bool extAppend)
+{
+    cache.clear();
     auto t0 = std::chrono::steady_clock::now();
     if (!mediaSwitch_) {
         auto res = ResourceUtil::CopyFileInner(src, dst);
-        CollectTime(totalCounts_, totalTime_, t0);
+        CollectTime(t0);
         return res;
     }
 
@@ -605,8 +720,13 @@ bool CompressionParser::CopyAndTranscode(const string &src, string &dst, const b
         break;
     }
     auto t2 = std::chrono::steady_clock::now();
-    auto ret = CopyForTrans(src, originDst, dst);
-    CollectTime(totalCounts_, totalTime_, t2);
+    string copied;
+    auto ret = CopyForTrans(src, dst, copied);
+    CollectTime(t2);
+    if (dst != originDst) {
+        cache = dst;
+    }
+    dst = copied;
     return ret;
 }
 
@@ -638,6 +758,26 @@ bool CompressionParser::CheckAndScaleIcon(const std::string &src, const std::str
     return true;
 }
 
+string CompressionParser::GetTranscodeGroup(const string &src)
+{
+    if (!mediaSwitch_ || compressFilters_.empty()) {
+        return "";
+    }
+    if (defaultCompress_) {
+        return GetMethod(compressFilters_.front());
+    }
+    for (const auto &compressFilter : compressFilters_) {
+        if (!IsInPath(src, compressFilter)) {
+            continue;
+        }
+        if (IsInExcludePath(src, compressFilter)) {
+            return GetRules(compressFilter) + "\n" + GetExcludeRules(compressFilter);
+        }
+        return GetRules(compressFilter);
+    }
+    return "";
+}
+
 bool CompressionParser::ScaleIconEnable()
 {
     return !filePath_.empty() && !outPath_.empty() && handle_ != nullptr;
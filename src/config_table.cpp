@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "config_table.h"
+#include <mutex>
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+using namespace std;
+const ConfigTable::Config *ConfigTable::Intern(const string &limitKey, const vector<KeyParam> &keyParams)
+{
+    return InternInner(limitKey, keyParams, nullptr);
+}
+
+const ConfigTable::Config *ConfigTable::Intern(const string &limitKey,
+    const shared_ptr<const vector<KeyParam>> &keyParams)
+{
+    return InternInner(limitKey, *keyParams, keyParams);
+}
+
+const ConfigTable::Config &ConfigTable::GetEmpty()
+{
+    static const Config empty = { 0, 0, "", make_shared<const vector<KeyParam>>() };
+    return empty;
+}
+
+// below private
+const ConfigTable::Config *ConfigTable::InternInner(const string &limitKey, const vector<KeyParam> &keyParams,
+    shared_ptr<const vector<KeyParam>> shared)
+{
+    if (limitKey.empty() && keyParams.empty()) {
+        return &GetEmpty();
+    }
+    string key = GetKey(limitKey, keyParams);
+    {
+        shared_lock<shared_mutex> lock(mutex_);
+        auto it = configIndex_.find(key);
+        if (it != configIndex_.end()) {
+            return it->second;
+        }
+    }
+    unique_lock<shared_mutex> lock(mutex_);
+    auto it = configIndex_.find(key);
+    if (it != configIndex_.end()) {
+        return it->second;
+    }
+    // the empty limit key is the limit key of the empty config
+    auto limitKeyId = limitKeyIds_.emplace(limitKey, limitKey.empty() ? 0 : limitKeyIds_.size() + 1).first;
+    Config config;
+    config.id = configs_.size() + 1;
+    config.limitKeyId = limitKeyId->second;
+    config.limitKey = limitKey;
+    // only a new config copies the key params, when they are not shared yet
+    config.keyParams = shared != nullptr ? move(shared) : make_shared<const vector<KeyParam>>(keyParams);
+    configs_.push_back(move(config));
+    configIndex_.emplace(move(key), &configs_.back());
+    return &configs_.back();
+}
+
+string ConfigTable::GetKey(const string &limitKey, const vector<KeyParam> &keyParams)
+{
+    string key = limitKey;
+    key.push_back('\0');
+    for (const auto &keyParam : keyParams) {
+        key.append(reinterpret_cast<const char *>(&keyParam.keyType), sizeof(keyParam.keyType));
+        key.append(reinterpret_cast<const char *>(&keyParam.value), sizeof(keyParam.value));
+    }
+    return key;
+}
+}
+}
+}
@@ -23,6 +23,16 @@
 #ifdef _WIN32
 #include "shlwapi.h"
 #include "windows.h"
+#else
+#include <fcntl.h>
+#endif
+#ifdef __LINUX__
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#endif
+#ifdef __MAC__
+#include <copyfile.h>
 #endif
 #include "resource_data.h"
 #include "restool_errors.h"
@@ -37,6 +47,10 @@ const std::string FileEntry::SEPARATE = "/";
 #endif
 
 using namespace std;
+#ifndef _WIN32
+constexpr size_t COPY_BUFFER_SIZE = 128 * 1024;
+#endif
+
 FileEntry::FileEntry(const string &path)
     : filePath_(path), isFile_(false)
 {
@@ -78,7 +92,12 @@ const vector<unique_ptr<FileEntry>> FileEntry::GetChilds() const
         wstring parentPathW = String2Wstring(filePath);
         string childPath = Wstring2String(parentPathW + L"\\" + filename);
         unique_ptr<FileEntry> f = make_unique<FileEntry>(childPath);
-        f->Init();
+        // the find data already has the type, a reparse point is resolved by Init
+        if ((findData.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) == 0) {
+            f->isFile_ = (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0;
+        } else {
+            f->Init();
+        }
         children.push_back(move(f));
     } while (FindNextFileW(handle, &findData));
     FindClose(handle);
@@ -96,7 +115,12 @@ const vector<unique_ptr<FileEntry>> FileEntry::GetChilds() const
 
         filePath = filePath_.GetPath() + SEPARATE + filename;
         unique_ptr<FileEntry> f = make_unique<FileEntry>(filePath);
-        f->Init();
+        // most file systems fill d_type, so no stat is needed, links and unknown types are resolved by Init
+        if (entry->d_type == DT_DIR || entry->d_type == DT_REG) {
+            f->isFile_ = entry->d_type == DT_REG;
+        } else {
+            f->Init();
+        }
         children.push_back(move(f));
     }
     closedir(handle);
@@ -152,30 +176,131 @@ bool FileEntry::RemoveFile(const string &path)
     return RemoveAllDirInner(f);
 }
 
+bool FileEntry::RemoveEmptyDir(const string &path)
+{
+    // fails without an error if the directory is not empty
+#ifdef _WIN32
+    return RemoveDirectoryW(AdaptLongPathW(path).c_str());
+#else
+    return rmdir(path.c_str()) == 0;
+#endif
+}
+
 bool FileEntry::CreateDirs(const string &path)
 {
-    return CreateDirsInner(path, 0);
+    // the directory usually exists or only misses its last level, so try it before the parents
+    bool parentMissing = false;
+    if (MakeDir(path, parentMissing)) {
+        return true;
+    }
+    if (!parentMissing) {
+        return false;
+    }
+    string::size_type pos = path.find_last_of(SEPARATE.front());
+    if (pos == string::npos || pos == 0) {
+        return false;
+    }
+    return CreateDirs(path.substr(0, pos)) && MakeDir(path, parentMissing);
 }
 
 bool FileEntry::CopyFileInner(const string &src, const string &dst)
 {
-#ifdef _WIN32
-    if (!CopyFileW(AdaptLongPathW(src).c_str(), AdaptLongPathW(dst).c_str(), false)) {
+    if (!TryCopyFile(src, dst)) {
         PrintError(GetError(ERR_CODE_COPY_FILE_ERROR).FormatCause(src.c_str(), dst.c_str(), strerror(errno)));
         return false;
     }
+    return true;
+}
+
+bool FileEntry::TryCopyFile(const string &src, const string &dst)
+{
+#ifdef _WIN32
+    return CopyFileW(AdaptLongPathW(src).c_str(), AdaptLongPathW(dst).c_str(), false) != 0;
 #else
-    ifstream in(src, ios::binary);
-    ofstream out(dst, ios::binary);
-    if (!in || !out) {
-        PrintError(GetError(ERR_CODE_COPY_FILE_ERROR).FormatCause(src.c_str(), dst.c_str(), strerror(errno)));
+    int in = open(src.c_str(), O_RDONLY);
+    if (in < 0) {
+        return false;
+    }
+    struct stat s;
+    int out = -1;
+    if (fstat(in, &s) != 0 || (out = open(dst.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666)) < 0) {
+        int err = errno;
+        close(in);
+        errno = err;
         return false;
     }
-    out << in.rdbuf();
+    bool ret = CopyFileData(in, out, static_cast<size_t>(s.st_size));
+    // keep the errno of the first failure for the caller
+    int err = errno;
+    if (close(out) != 0 && ret) {
+        err = errno;
+        ret = false;
+    }
+    close(in);
+    errno = err;
+    return ret;
 #endif
-    return true;
 }
 
+#ifndef _WIN32
+bool FileEntry::CopyFileData(int in, int out, size_t size)
+{
+    // every step continues from the file offsets left by the previous one, the last one copies up to the end
+#ifdef __LINUX__
+    // a clone shares the blocks until either file is written, it fails on file systems without reflink
+    if (ioctl(out, FICLONE, in) == 0) {
+        return true;
+    }
+    size_t copied = 0;
+    while (copied < size) {
+        ssize_t count = copy_file_range(in, nullptr, out, nullptr, size - copied, 0);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            break;
+        }
+        copied += static_cast<size_t>(count);
+    }
+    while (copied < size) {
+        ssize_t count = sendfile(out, in, nullptr, size - copied);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            break;
+        }
+        copied += static_cast<size_t>(count);
+    }
+#elif defined(__MAC__)
+    // copies in the kernel and clones on APFS
+    if (fcopyfile(in, out, nullptr, COPYFILE_DATA) == 0) {
+        return true;
+    }
+#endif
+    vector<char> buffer(COPY_BUFFER_SIZE);
+    while (true) {
+        ssize_t count = read(in, buffer.data(), buffer.size());
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return count == 0;
+        }
+        for (ssize_t written = 0; written < count;) {
+            ssize_t ret = write(out, buffer.data() + written, count - written);
+            if (ret < 0 && errno == EINTR) {
+                continue;
+            }
+            if (ret < 0) {
+                return false;
+            }
+            written += ret;
+        }
+    }
+}
+#endif
+
 bool FileEntry::IsDirectory(const string &path)
 {
 #ifdef _WIN32
@@ -337,28 +462,23 @@ bool FileEntry::RemoveAllDirInner(const FileEntry &entry)
     return true;
 }
 
-bool FileEntry::CreateDirsInner(const string &path, string::size_type offset)
+bool FileEntry::MakeDir(const string &path, bool &parentMissing)
 {
-    string::size_type pos = path.find_first_of(SEPARATE.front(), offset);
-    if (pos == string::npos) {
+    // an existing directory (not a file) counts as created, so threads creating the same directory do not fail
 #ifdef _WIN32
-        return CreateDirectoryW(AdaptLongPathW(path).c_str(), nullptr);
-#else
-        return mkdir(path.c_str(), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH) == 0;
-#endif
+    if (CreateDirectoryW(AdaptLongPathW(path).c_str(), nullptr)) {
+        return true;
     }
-
-    string subPath = path.substr(0, pos + 1);
-    if (!Exist(subPath)) {
-#ifdef _WIN32
-        if (!CreateDirectoryW(AdaptLongPathW(subPath).c_str(), nullptr)) {
+    DWORD error = GetLastError();
+    parentMissing = error == ERROR_PATH_NOT_FOUND;
+    return error == ERROR_ALREADY_EXISTS && IsDirectory(path);
 #else
-        if (mkdir(subPath.c_str(), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH) != 0) {
-#endif
-            return false;
-        }
+    if (mkdir(path.c_str(), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH) == 0) {
+        return true;
     }
-    return CreateDirsInner(path, pos + 1);
+    parentMissing = errno == ENOENT;
+    return errno == EEXIST && IsDirectory(path);
+#endif
 }
 
 void FileEntry::FilePath::Format()
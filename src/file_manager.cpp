@@ -15,6 +15,7 @@
 
 #include "file_manager.h"
 #include <algorithm>
+#include <atomic>
 #include "compression_parser.h"
 #include <iostream>
 #include "resource_compiler_factory.h"
@@ -25,6 +26,8 @@
 #include "resource_util.h"
 #include "restool_errors.h"
 #include "resource_module.h"
+#include "thread_pool.h"
+#include "tracer.h"
 
 namespace OHOS {
 namespace Global {
@@ -32,12 +35,39 @@ namespace Restool {
 using namespace std;
 uint32_t FileManager::ScanModules(const vector<string> &inputs, const string &output, const bool isHar)
 {
+    vector<unique_ptr<ResourceModule>> modules;
+    for (const auto &input : inputs) {
+        modules.push_back(make_unique<ResourceModule>(input, output, moduleName_));
+    }
+
+    // the directories of the modules are scanned concurrently, the modules after the first failed one are skipped
+    vector<string> errors(modules.size());
+    atomic<size_t> firstFailed(modules.size());
+    ThreadPool::GetInstance().ParallelFor(modules.size(), [&modules, &errors, &firstFailed](size_t i) {
+        if (i > firstFailed) {
+            return RESTOOL_SUCCESS;
+        }
+        string *lastBuffer = SetErrorBuffer(&errors[i]);
+        uint32_t ret = modules[i]->ScanDirectorys();
+        SetErrorBuffer(lastBuffer);
+        if (ret != RESTOOL_SUCCESS) {
+            size_t failed = firstFailed;
+            while (i < failed && !firstFailed.compare_exchange_weak(failed, i)) {}
+        }
+        return ret;
+    });
+
+    // ids are generated and resources are overridden in input order, as the merge order of ResourceMerge
     vector<pair<ResType, string>> noBaseResource;
-    for (auto input : inputs) {
-        if (ScanModule(input, output) != RESTOOL_SUCCESS) {
+    set<pair<ResType, string>> noBaseSet;
+    for (size_t i = 0; i < modules.size(); i++) {
+        PrintErrors(errors[i]);
+        if (i == firstFailed || modules[i]->CompileDirectorys(scanHap_) != RESTOOL_SUCCESS) {
             return RESTOOL_ERROR;
         }
-        CheckAllItems(noBaseResource);
+        MergeResourceItem(modules[i]->GetOwner());
+        CheckItems(modules[i]->GetOwner(), noBaseResource, noBaseSet);
+        modules[i].reset();
     }
     if (!noBaseResource.empty()) {
         ResourceUtil::PrintWarningMsg(noBaseResource);
@@ -51,18 +81,9 @@ uint32_t FileManager::MergeResourceItem(const map<int64_t, vector<ResourceItem>>
 }
 
 // below private founction
-uint32_t FileManager::ScanModule(const string &input, const string &output)
-{
-    ResourceModule resourceModule(input, output, moduleName_);
-    if (resourceModule.ScanResource(scanHap_) != RESTOOL_SUCCESS) {
-        return RESTOOL_ERROR;
-    }
-    MergeResourceItem(resourceModule.GetOwner());
-    return RESTOOL_SUCCESS;
-}
-
 uint32_t FileManager::ParseReference(const string &output)
 {
+    TraceScope scope("ParseRefInResources");
     ReferenceParser referenceParser;
     if (referenceParser.ParseRefInResources(items_, output) != RESTOOL_SUCCESS) {
         return RESTOOL_ERROR;
@@ -70,20 +91,23 @@ uint32_t FileManager::ParseReference(const string &output)
     return RESTOOL_SUCCESS;
 }
 
-void FileManager::CheckAllItems(vector<pair<ResType, string>> &noBaseResource)
+void FileManager::CheckItems(const map<int64_t, vector<ResourceItem>> &merged,
+    vector<pair<ResType, string>> &noBaseResource, set<pair<ResType, string>> &noBaseSet) const
 {
-    for (const auto &item : items_) {
-        bool found = any_of(item.second.begin(), item.second.end(), [](const auto &iter) {
+    // an id only changes when a module merges it, so only the ids of the last merged module are checked
+    for (const auto &mergedItem : merged) {
+        auto item = items_.find(mergedItem.first);
+        if (item == items_.end() || item->second.empty()) {
+            continue;
+        }
+        bool found = any_of(item->second.begin(), item->second.end(), [](const auto &iter) {
             return iter.GetLimitKey() == "base";
         });
         if (!found) {
-            auto firstItem = item.second.front();
-            bool ret = any_of(noBaseResource.begin(), noBaseResource.end(), [firstItem](const auto &iterItem) {
-                return (firstItem.GetResType() == iterItem.first)  &&
-                    (firstItem.GetName() == iterItem.second);
-            });
-            if (!ret) {
-                noBaseResource.push_back(make_pair(firstItem.GetResType(), firstItem.GetName()));
+            const auto &firstItem = item->second.front();
+            auto key = make_pair(firstItem.GetResType(), firstItem.GetName());
+            if (noBaseSet.insert(key).second) {
+                noBaseResource.push_back(move(key));
             }
         }
     }
@@ -91,6 +115,7 @@ void FileManager::CheckAllItems(vector<pair<ResType, string>> &noBaseResource)
 
 bool FileManager::ScaleIcons(const string &output, const std::map<std::string, std::set<uint32_t>> &iconMap)
 {
+    TraceScope scope("ScaleIcons");
     if (!CompressionParser::GetCompressionParser()->ScaleIconEnable()) {
         cout << "Info: scale icon is not enable." << endl;
         return true;
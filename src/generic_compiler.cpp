@@ -15,13 +15,17 @@
 
 #include "generic_compiler.h"
 
+#include <algorithm>
 #include <iostream>
+#include <numeric>
 
+#include "build_state.h"
 #include "compression_parser.h"
 #include "file_entry.h"
 #include "id_worker.h"
 #include "resource_util.h"
 #include "restool_errors.h"
+#include "sharded_set.h"
 #include "thread_pool.h"
 
 namespace OHOS {
@@ -40,17 +44,23 @@ GenericCompiler::~GenericCompiler()
 uint32_t GenericCompiler::CompileFiles(const std::vector<FileInfo> &fileInfos)
 {
     cout << "Info: GenericCompiler::CompileFiles" << endl;
-    std::vector<std::future<uint32_t>> results;
-    for (const auto &fileInfo : fileInfos) {
-        auto taskFunc = [this](const FileInfo &fileInfo) { return this->CompileSingleFile(fileInfo); };
-        results.push_back(ThreadPool::GetInstance().Enqueue(taskFunc, fileInfo));
-    }
-    for (auto &ret : results) {
-        if (ret.get() != RESTOOL_SUCCESS) {
-            return RESTOOL_ERROR;
+    // media files of the same transcode options are compiled together, the options are switched once per group
+    vector<size_t> order(fileInfos.size());
+    iota(order.begin(), order.end(), 0);
+    if (moduleName_ != "har" && type_ == ResType::MEDIA) {
+        auto compressionParser = CompressionParser::GetCompressionParser();
+        vector<string> groups;
+        groups.reserve(fileInfos.size());
+        for (const auto &fileInfo : fileInfos) {
+            groups.push_back(compressionParser->GetTranscodeGroup(fileInfo.filePath));
         }
+        stable_sort(order.begin(), order.end(), [&groups](size_t a, size_t b) {
+            return groups[a] < groups[b];
+        });
     }
-    return RESTOOL_SUCCESS;
+    return ThreadPool::GetInstance().ParallelFor(order.size(), [this, &fileInfos, &order](size_t index) {
+        return this->CompileSingleFile(fileInfos[order[index]]);
+    });
 }
 
 uint32_t GenericCompiler::CompileSingleFile(const FileInfo &fileInfo)
@@ -60,8 +70,13 @@ uint32_t GenericCompiler::CompileSingleFile(const FileInfo &fileInfo)
     }
 
     string output = "";
-    if (!CopyMediaFile(fileInfo, output)) {
-        return RESTOOL_ERROR;
+    BuildState &buildState = BuildState::GetInstance();
+    if (!buildState.GetOutput(fileInfo.filePath, output)) {
+        string cache;
+        if (!CopyMediaFile(fileInfo, output, cache)) {
+            return RESTOOL_ERROR;
+        }
+        buildState.SetOutput(fileInfo.filePath, output, cache);
     }
 
     if (!PostMediaFile(fileInfo, output)) {
@@ -73,9 +88,8 @@ uint32_t GenericCompiler::CompileSingleFile(const FileInfo &fileInfo)
 bool GenericCompiler::PostMediaFile(const FileInfo &fileInfo, const std::string &output)
 {
     std::lock_guard<std::mutex> lock(mutex_);
-    ResourceItem resourceItem(fileInfo.filename, fileInfo.keyParams, type_);
+    ResourceItem resourceItem(fileInfo.filename, fileInfo.limitKey, fileInfo.keyParams, type_);
     resourceItem.SetFilePath(fileInfo.filePath);
-    resourceItem.SetLimitKey(fileInfo.limitKey);
 
     auto index = output.find_last_of(SEPARATOR_FILE);
     if (index == string::npos) {
@@ -107,11 +121,8 @@ string GenericCompiler::GetOutputFilePath(const FileInfo &fileInfo) const
 
 bool GenericCompiler::IsIgnore(const FileInfo &fileInfo)
 {
-    lock_guard<mutex> lock(mutex_);
-    string output = GetOutputFilePath(fileInfo);
-    if (g_hapResourceSet.count(output)) {
-        g_hapResourceSet.erase(output);
-    } else if (!g_resourceSet.emplace(output).second) {
+    ShardedSet::Key output = ShardedSet::MakeKey(GetOutputFilePath(fileInfo));
+    if (!g_hapResourceSet.Erase(output) && !g_resourceSet.Insert(output)) {
         if (isHarResource_) {
             string idName = ResourceUtil::GetIdName(fileInfo.filename, fileInfo.dirType);
             int64_t id = IdWorker::GetInstance().GetId(fileInfo.dirType, idName);
@@ -123,7 +134,7 @@ bool GenericCompiler::IsIgnore(const FileInfo &fileInfo)
     return false;
 }
 
-bool GenericCompiler::CopyMediaFile(const FileInfo &fileInfo, std::string &output)
+bool GenericCompiler::CopyMediaFile(const FileInfo &fileInfo, std::string &output, std::string &cache)
 {
     string outputFolder = GetOutputFolder(fileInfo);
     if (!ResourceUtil::CreateDirs(outputFolder)) {
@@ -133,7 +144,7 @@ bool GenericCompiler::CopyMediaFile(const FileInfo &fileInfo, std::string &outpu
     if (moduleName_ == "har" || type_ != ResType::MEDIA) {
         return ResourceUtil::CopyFileInner(fileInfo.filePath, output);
     } else {
-        return CompressionParser::GetCompressionParser()->CopyAndTranscode(fileInfo.filePath, output);
+        return CompressionParser::GetCompressionParser()->CopyAndTranscode(fileInfo.filePath, output, cache, false);
     }
 }
 }
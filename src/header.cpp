@@ -18,6 +18,7 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include "output_sink.h"
 
 namespace OHOS {
 namespace Global {
@@ -51,12 +52,6 @@ uint32_t Header::Create(HandleHeaderTail headerHandler, HandleBody bodyHandler,
     IdWorker &idWorker = IdWorker::GetInstance();
     vector<ResourceId> resourceIds = idWorker.GetHeaderId();
 
-    ofstream out(outputPath_, ofstream::out | ofstream::binary);
-    if (!out.is_open()) {
-        PrintError(GetError(ERR_CODE_OPEN_FILE_ERROR).FormatCause(outputPath_.c_str(), strerror(errno)));
-        return RESTOOL_ERROR;
-    }
-
     stringstream buffer;
     if (headerHandler) {
         headerHandler(buffer);
@@ -69,8 +64,9 @@ uint32_t Header::Create(HandleHeaderTail headerHandler, HandleBody bodyHandler,
     if (tailHandler) {
         tailHandler(buffer);
     }
-    out << buffer.rdbuf();
-    out.close();
+    if (!OutputSink::GetInstance().Write(outputPath_, buffer.str())) {
+        return RESTOOL_ERROR;
+    }
     return RESTOOL_SUCCESS;
 }
 }
@@ -15,11 +15,14 @@
 
 #include "i_resource_compiler.h"
 #include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <iterator>
 #include "file_entry.h"
 #include "id_worker.h"
 #include "resource_util.h"
 #include "restool_errors.h"
+#include "thread_pool.h"
 
 namespace OHOS {
 namespace Global {
@@ -38,29 +41,31 @@ IResourceCompiler::~IResourceCompiler()
 
 uint32_t IResourceCompiler::Compile(const vector<DirectoryInfo> &directoryInfos)
 {
-    vector<FileInfo> fileInfos;
-    map<string, vector<FileInfo>> setsByDirectory;
-    for (const auto &directoryInfo : directoryInfos) {
-        string outputFolder = GetOutputFolder(directoryInfo);
-        FileEntry f(directoryInfo.dirPath);
-        if (!f.Init()) {
+    // the directories are listed in parallel, the first error in directory order is reported
+    vector<ListResult> results(directoryInfos.size());
+    atomic<size_t> firstFailed(directoryInfos.size());
+    ThreadPool::GetInstance().ParallelFor(directoryInfos.size(), [&directoryInfos, &results, &firstFailed](size_t i) {
+        if (i > firstFailed) {
+            return RESTOOL_SUCCESS;
+        }
+        string *lastBuffer = SetErrorBuffer(&results[i].errors);
+        results[i].success = ListFiles(directoryInfos[i], results[i].fileInfos);
+        SetErrorBuffer(lastBuffer);
+        if (!results[i].success) {
+            size_t failed = firstFailed;
+            while (i < failed && !firstFailed.compare_exchange_weak(failed, i)) {}
             return RESTOOL_ERROR;
         }
-        for (const auto &it : f.GetChilds()) {
-            if (ResourceUtil::IsIgnoreFile(*it)) {
-                continue;
-            }
-
-            if (!it->IsFile()) {
-                PrintError(GetError(ERR_CODE_INVALID_RESOURCE_PATH)
-                    .FormatCause(it->GetFilePath().GetPath().c_str(), "not a file"));
-                return RESTOOL_ERROR;
-            }
-
-            FileInfo fileInfo = { directoryInfo, it->GetFilePath().GetPath(), it->GetFilePath().GetFilename() };
-            fileInfos.push_back(fileInfo);
-            setsByDirectory[outputFolder].push_back(fileInfo);
+        return RESTOOL_SUCCESS;
+    });
+
+    vector<FileInfo> fileInfos;
+    for (auto &result : results) {
+        if (!result.success) {
+            PrintErrors(result.errors);
+            return RESTOOL_ERROR;
         }
+        move(result.fileInfos.begin(), result.fileInfos.end(), back_inserter(fileInfos));
     }
 
     sort(fileInfos.begin(), fileInfos.end(), [](const auto &a, const auto &b) {
@@ -148,7 +153,7 @@ bool IResourceCompiler::MergeResourceItem(const ResourceItem &resourceItem)
     }
 
     auto ret = find_if(item->second.begin(), item->second.end(), [resourceItem](auto &iter) {
-        return resourceItem.GetLimitKey() == iter.GetLimitKey();
+        return resourceItem.GetLimitKeyId() == iter.GetLimitKeyId();
     });
     if (ret != item->second.end()) {
         PrintError(GetError(ERR_CODE_RESOURCE_DUPLICATE)
@@ -159,6 +164,28 @@ bool IResourceCompiler::MergeResourceItem(const ResourceItem &resourceItem)
     return true;
 }
 
+bool IResourceCompiler::ListFiles(const DirectoryInfo &directoryInfo, vector<FileInfo> &fileInfos)
+{
+    FileEntry f(directoryInfo.dirPath);
+    if (!f.Init()) {
+        return false;
+    }
+    for (const auto &it : f.GetChilds()) {
+        if (ResourceUtil::IsIgnoreFile(*it)) {
+            continue;
+        }
+
+        if (!it->IsFile()) {
+            PrintError(GetError(ERR_CODE_INVALID_RESOURCE_PATH)
+                .FormatCause(it->GetFilePath().GetPath().c_str(), "not a file"));
+            return false;
+        }
+
+        fileInfos.push_back({ directoryInfo, it->GetFilePath().GetPath(), it->GetFilePath().GetFilename() });
+    }
+    return true;
+}
+
 string IResourceCompiler::GetOutputFolder(const DirectoryInfo &directoryInfo) const
 {
     string outputFolder = FileEntry::FilePath(output_).Append(RESOURCES_DIR)
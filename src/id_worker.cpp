@@ -33,6 +33,11 @@ uint32_t IdWorker::Init(ResourceIdCluster &type, int64_t startId)
     }
     sysDefinedIds_ = idDefinedParser.GetSysDefinedIds();
     appDefinedIds_ = idDefinedParser.GetAppDefinedIds();
+    reservedIds_.clear();
+    reservedIds_.reserve(appDefinedIds_.size());
+    for (const auto &defined : appDefinedIds_) {
+        reservedIds_.insert(defined.second.id);
+    }
     if (type == ResourceIdCluster::RES_ID_APP) {
         appId_ = static_cast<uint64_t>(startId);
         maxId_ = GetMaxId(startId);
@@ -105,6 +110,27 @@ int64_t IdWorker::LoadIdFromHap(map<int64_t, vector<ResourceItem>> &items)
     return RESTOOL_SUCCESS;
 }
 
+void IdWorker::SetCacheIds(const map<pair<ResType, string>, int64_t> &ids)
+{
+    if (type_ != ResourceIdCluster::RES_ID_APP) {
+        return;
+    }
+    for (const auto &it : ids) {
+        // ids of the last build that are now out of range or defined in id_defined.json are assigned again
+        if (it.second < static_cast<int64_t>(appId_) || static_cast<uint64_t>(it.second) > maxId_ ||
+            reservedIds_.count(it.second) != 0 || appDefinedIds_.count(it.first) != 0) {
+            continue;
+        }
+        cacheIds_.emplace(it.first, it.second);
+        reservedIds_.insert(it.second);
+    }
+}
+
+const map<pair<ResType, string>, int64_t> &IdWorker::GetIds() const
+{
+    return ids_;
+}
+
 int64_t IdWorker::GenerateAppId(ResType resType, const string &name)
 {
     auto result = ids_.find(make_pair(resType, name));
@@ -128,15 +154,9 @@ int64_t IdWorker::GenerateAppId(ResType resType, const string &name)
         PrintError(GetError(ERR_CODE_RESOURCE_ID_EXCEED).FormatCause(appId_, maxId_));
         return -1;
     }
-    int64_t id = -1;
-    if (!delIds_.empty()) {
-        id = delIds_.front();
-        delIds_.erase(delIds_.begin());
-    } else {
-        id = GetCurId();
-        if (id < 0) {
-            return -1;
-        }
+    int64_t id = GetCurId();
+    if (id < 0) {
+        return -1;
     }
     ids_.emplace(make_pair(resType, name), id);
     return id;
@@ -144,15 +164,10 @@ int64_t IdWorker::GenerateAppId(ResType resType, const string &name)
 
 int64_t IdWorker::GetCurId()
 {
-    if (appDefinedIds_.size() == 0) {
-        return static_cast<int64_t>(appId_++);
-    }
+    // appId_ only moves forward, so every reserved id is skipped at most once
     while (appId_ <= maxId_) {
         int64_t id = static_cast<int64_t>(appId_);
-        auto ret = find_if(appDefinedIds_.begin(), appDefinedIds_.end(), [id](const auto &iter) {
-            return id == iter.second.id;
-        });
-        if (ret == appDefinedIds_.end()) {
+        if (reservedIds_.count(id) == 0) {
             return static_cast<int64_t>(appId_++);
         }
         appId_++;
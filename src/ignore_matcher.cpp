@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ignore_matcher.h"
+#include <cctype>
+#include <cstring>
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+using namespace std;
+namespace {
+const char *REGEX_SPECIAL_CHARS = ".^$|?*+()[]{}";
+const string ANY_ONE_OR_MORE = ".+";
+const string ANY_ZERO_OR_MORE = ".*";
+}
+
+IgnoreMatcher::IgnoreMatcher(const map<string, IgnoreType> &patterns)
+{
+    string errMsg;
+    for (const auto &iter : patterns) {
+        AddPattern(iter.first, iter.second, errMsg);
+    }
+}
+
+bool IgnoreMatcher::AddPattern(const string &pattern, IgnoreType ignoreType, string &errMsg)
+{
+    Pattern compiled;
+    try {
+        compiled.regex = regex(pattern);
+    } catch (regex_error &err) {
+        errMsg = err.what();
+        return false;
+    }
+    compiled.ignoreType = ignoreType;
+    Classify(pattern, compiled);
+    patterns_[pattern] = move(compiled);
+    return true;
+}
+
+IgnoreMatcher::MatchResult IgnoreMatcher::Match(const string &fileName, const string &filePath,
+    bool isFile, bool matchPath) const
+{
+    MatchResult result;
+    for (const auto &iter : patterns_) {
+        IgnoreType ignoreType = iter.second.ignoreType;
+        if ((ignoreType == IgnoreType::IGNORE_FILE && !isFile) || (ignoreType == IgnoreType::IGNORE_DIR && isFile)) {
+            continue;
+        }
+        if (IsMatch(iter.second, fileName)) {
+            result.pattern = &iter.first;
+            return result;
+        }
+        if (matchPath && IsMatch(iter.second, filePath)) {
+            result.pattern = &iter.first;
+            result.isPath = true;
+            return result;
+        }
+    }
+    return result;
+}
+
+// a pattern without any special char, escaped punctuations such as '\.' are taken literally
+bool IgnoreMatcher::ParseLiteral(const string &pattern, string &literal)
+{
+    literal.clear();
+    for (size_t i = 0; i < pattern.length(); i++) {
+        char c = pattern[i];
+        if (c == '\\') {
+            if (i + 1 >= pattern.length() || !ispunct(static_cast<unsigned char>(pattern[i + 1]))) {
+                return false;
+            }
+            literal.push_back(pattern[++i]);
+            continue;
+        }
+        if (strchr(REGEX_SPECIAL_CHARS, c) != nullptr) {
+            return false;
+        }
+        literal.push_back(c);
+    }
+    return true;
+}
+
+void IgnoreMatcher::Classify(const string &source, Pattern &pattern)
+{
+    size_t wildcardLen = ANY_ONE_OR_MORE.length();
+    if (ParseLiteral(source, pattern.literal)) {
+        pattern.kind = MatchKind::LITERAL;
+        return;
+    }
+    if (source.length() >= wildcardLen) {
+        string head = source.substr(0, wildcardLen);
+        string tail = source.substr(source.length() - wildcardLen);
+        if ((head == ANY_ONE_OR_MORE || head == ANY_ZERO_OR_MORE) &&
+            ParseLiteral(source.substr(wildcardLen), pattern.literal)) {
+            pattern.kind = MatchKind::SUFFIX;
+            pattern.minWildcardLen = head == ANY_ONE_OR_MORE ? 1 : 0;
+            return;
+        }
+        if ((tail == ANY_ONE_OR_MORE || tail == ANY_ZERO_OR_MORE) &&
+            ParseLiteral(source.substr(0, source.length() - wildcardLen), pattern.literal)) {
+            pattern.kind = MatchKind::PREFIX;
+            pattern.minWildcardLen = tail == ANY_ONE_OR_MORE ? 1 : 0;
+            return;
+        }
+    }
+    pattern.literal.clear();
+    pattern.kind = MatchKind::REGEX;
+}
+
+// '.' matches any char except line terminators
+bool IgnoreMatcher::IsWildcard(const string &str, size_t pos, size_t len)
+{
+    for (size_t i = pos; i < pos + len; i++) {
+        if (str[i] == '\n' || str[i] == '\r') {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool IgnoreMatcher::IsMatch(const Pattern &pattern, const string &name)
+{
+    const string &literal = pattern.literal;
+    switch (pattern.kind) {
+        case MatchKind::LITERAL:
+            return name == literal;
+        case MatchKind::PREFIX:
+            return name.length() >= literal.length() + pattern.minWildcardLen &&
+                name.compare(0, literal.length(), literal) == 0 &&
+                IsWildcard(name, literal.length(), name.length() - literal.length());
+        case MatchKind::SUFFIX:
+            return name.length() >= literal.length() + pattern.minWildcardLen &&
+                name.compare(name.length() - literal.length(), literal.length(), literal) == 0 &&
+                IsWildcard(name, 0, name.length() - literal.length());
+        default:
+            return regex_match(name, pattern.regex);
+    }
+}
+}
+}
+}
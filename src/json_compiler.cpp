@@ -14,10 +14,14 @@
  */
 
 #include "json_compiler.h"
+#include <atomic>
 #include <iostream>
 #include <limits>
 #include <regex>
+#include "build_state.h"
+#include "json_document.h"
 #include "restool_errors.h"
+#include "thread_pool.h"
 #include "translatable_parser.h"
 
 namespace OHOS {
@@ -32,37 +36,83 @@ const vector<string> QUANTITY_ATTRS = { "zero", "one", "two", "few", "many", "ot
 const vector<string> TRANSLATION_TYPE = { "string", "strarray", "plural" };
 
 JsonCompiler::JsonCompiler(ResType type, const string &output, bool isOverlap, bool isHarResource)
-    : IResourceCompiler(type, output, isOverlap, isHarResource), isBaseString_(false), root_(nullptr)
+    : IResourceCompiler(type, output, isOverlap, isHarResource)
 {
     InitParser();
 }
 
 JsonCompiler::~JsonCompiler()
 {
-    if (root_) {
-        cJSON_Delete(root_);
-    }
 }
 
 uint32_t JsonCompiler::CompileSingleFile(const FileInfo &fileInfo)
+{
+    ParseResult result;
+    ParseFile(fileInfo, result);
+    return MergeParseResult(result);
+}
+
+uint32_t JsonCompiler::CompileFiles(const std::vector<FileInfo> &fileInfos)
+{
+    // the files after the first one that fails to parse are skipped, their results are never merged
+    vector<ParseResult> results(fileInfos.size());
+    atomic<size_t> firstFailed(fileInfos.size());
+    ThreadPool::GetInstance().ParallelFor(fileInfos.size(), [this, &fileInfos, &results, &firstFailed](size_t i) {
+        if (i > firstFailed) {
+            return RESTOOL_SUCCESS;
+        }
+        ParseFile(fileInfos[i], results[i]);
+        if (!results[i].success) {
+            size_t failed = firstFailed;
+            while (i < failed && !firstFailed.compare_exchange_weak(failed, i)) {}
+        }
+        return RESTOOL_SUCCESS;
+    });
+
+    // merge in file order, so that the items and the first error are the same as a serial compilation
+    for (const auto &result : results) {
+        if (MergeParseResult(result) != RESTOOL_SUCCESS) {
+            return RESTOOL_ERROR;
+        }
+    }
+    return RESTOOL_SUCCESS;
+}
+
+// below private
+void JsonCompiler::ParseFile(const FileInfo &fileInfo, ParseResult &result) const
 {
     if (fileInfo.limitKey == "base" &&
         fileInfo.fileCluster == "element" &&
         fileInfo.filename == ID_DEFINED_FILE) {
-        return RESTOOL_SUCCESS;
+        return;
+    }
+    if (BuildState::GetInstance().GetItems(fileInfo.filePath, result.items)) {
+        return;
     }
 
-    if (!ResourceUtil::OpenJsonFile(fileInfo.filePath, &root_)) {
-        return RESTOOL_ERROR;
+    string *lastBuffer = SetErrorBuffer(&result.errors);
+    JsonDocument document;
+    if (!document.Load(fileInfo.filePath)) {
+        result.success = false;
+    } else {
+        result.success = ParseRoot(document.GetRoot(), fileInfo, result);
     }
-    if (!root_ || !cJSON_IsObject(root_)) {
+    SetErrorBuffer(lastBuffer);
+    if (result.success) {
+        BuildState::GetInstance().SetItems(fileInfo.filePath, result.items);
+    }
+}
+
+bool JsonCompiler::ParseRoot(cJSON *root, const FileInfo &fileInfo, ParseResult &result) const
+{
+    if (!root || !cJSON_IsObject(root)) {
         PrintError(GetError(ERR_CODE_JSON_FORMAT_ERROR).SetPosition(fileInfo.filePath));
-        return RESTOOL_ERROR;
+        return false;
     }
-    cJSON *item = root_->child;
-    if (cJSON_GetArraySize(root_) != 1) {
+    cJSON *item = root->child;
+    if (cJSON_GetArraySize(root) != 1) {
         PrintError(GetError(ERR_CODE_JSON_NOT_ONE_MEMBER).FormatCause("root").SetPosition(fileInfo.filePath));
-        return RESTOOL_ERROR;
+        return false;
     }
 
     string tag = item->string;
@@ -71,19 +121,26 @@ uint32_t JsonCompiler::CompileSingleFile(const FileInfo &fileInfo)
         PrintError(GetError(ERR_CODE_JSON_INVALID_NODE_NAME)
                        .FormatCause(tag.c_str(), ResourceUtil::GetAllRestypeString().c_str())
                        .SetPosition(fileInfo.filePath));
-        return RESTOOL_ERROR;
+        return false;
     }
-    isBaseString_ = (fileInfo.limitKey == "base" &&
+    result.isBaseString = (fileInfo.limitKey == "base" &&
         find(TRANSLATION_TYPE.begin(), TRANSLATION_TYPE.end(), tag) != TRANSLATION_TYPE.end());
     FileInfo copy = fileInfo;
     copy.fileType = ret->second;
-    if (!ParseJsonArrayLevel(item, copy)) {
-        return RESTOOL_ERROR;
+    return ParseJsonArrayLevel(item, copy, result);
+}
+
+uint32_t JsonCompiler::MergeParseResult(const ParseResult &result)
+{
+    for (const auto &resourceItem : result.items) {
+        if (!MergeResourceItem(resourceItem)) {
+            return RESTOOL_ERROR;
+        }
     }
-    return RESTOOL_SUCCESS;
+    PrintErrors(result.errors);
+    return result.success ? RESTOOL_SUCCESS : RESTOOL_ERROR;
 }
 
-// below private
 void JsonCompiler::InitParser()
 {
     using namespace placeholders;
@@ -100,7 +157,7 @@ void JsonCompiler::InitParser()
     handles_.emplace(ResType::SYMBOL, bind(&JsonCompiler::HandleSymbol, this, _1, _2));
 }
 
-bool JsonCompiler::ParseJsonArrayLevel(const cJSON *arrayNode, const FileInfo &fileInfo)
+bool JsonCompiler::ParseJsonArrayLevel(const cJSON *arrayNode, const FileInfo &fileInfo, ParseResult &result) const
 {
     if (!arrayNode || !cJSON_IsArray(arrayNode)) {
         PrintError(GetError(ERR_CODE_JSON_NODE_MISMATCH)
@@ -123,14 +180,14 @@ bool JsonCompiler::ParseJsonArrayLevel(const cJSON *arrayNode, const FileInfo &f
                 .SetPosition(fileInfo.filePath));
             return false;
         }
-        if (!ParseJsonObjectLevel(item, fileInfo)) {
+        if (!ParseJsonObjectLevel(item, fileInfo, result)) {
             return false;
         }
     }
     return true;
 }
 
-bool JsonCompiler::ParseJsonObjectLevel(cJSON *objectNode, const FileInfo &fileInfo)
+bool JsonCompiler::ParseJsonObjectLevel(cJSON *objectNode, const FileInfo &fileInfo, ParseResult &result) const
 {
     cJSON *nameNode = cJSON_GetObjectItem(objectNode, TAG_NAME.c_str());
     if (!nameNode) {
@@ -144,12 +201,11 @@ bool JsonCompiler::ParseJsonObjectLevel(cJSON *objectNode, const FileInfo &fileI
         return false;
     }
 
-    if (isBaseString_ && !TranslatableParse::ParseTranslatable(objectNode, fileInfo, nameNode->valuestring)) {
+    if (result.isBaseString && !TranslatableParse::ParseTranslatable(objectNode, fileInfo, nameNode->valuestring)) {
         return false;
     }
-    ResourceItem resourceItem(nameNode->valuestring, fileInfo.keyParams, fileInfo.fileType);
+    ResourceItem resourceItem(nameNode->valuestring, fileInfo.limitKey, fileInfo.keyParams, fileInfo.fileType);
     resourceItem.SetFilePath(fileInfo.filePath);
-    resourceItem.SetLimitKey(fileInfo.limitKey);
     auto ret = handles_.find(fileInfo.fileType);
     if (ret == handles_.end()) {
         std::string elementTypes = "[";
@@ -172,7 +228,8 @@ bool JsonCompiler::ParseJsonObjectLevel(cJSON *objectNode, const FileInfo &fileI
         resourceItem.MarkCoverable();
     }
 
-    return MergeResourceItem(resourceItem);
+    result.items.push_back(move(resourceItem));
+    return true;
 }
 
 bool JsonCompiler::HandleString(const cJSON *objectNode, ResourceItem &resourceItem) const
@@ -371,7 +428,7 @@ bool JsonCompiler::CheckJsonStringValue(const cJSON *valueNode, const ResourceIt
             .SetPosition(resourceItem.GetFilePath()));
         return false;
     }
-    regex ref("^\\$.+:");
+    static const regex ref("^\\$.+:");
     smatch result;
     if (regex_search(value, result, ref) && !regex_match(result[0].str(), regex(REFS.at(type)))) {
         PrintError(GetError(ERR_CODE_INVALID_RESOURCE_REF).FormatCause(value.c_str(), REFS.at(type).c_str())
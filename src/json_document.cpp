@@ -0,0 +1,472 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "json_document.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include "mapped_file.h"
+#include "resource_util.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+using namespace std;
+namespace {
+constexpr size_t BLOCK_SIZE = 256 * 1024;
+// below the cJSON nesting limit, deeper documents are left to cJSON
+constexpr size_t MAX_DEPTH = 512;
+// cJSON parses at most 63 characters of a number
+constexpr size_t NUMBER_MAX_LEN = 64;
+const char UTF8_BOM[] = "\xEF\xBB\xBF";
+constexpr size_t UTF8_BOM_LEN = 3;
+constexpr uint32_t HIGH_SURROGATE_MIN = 0xD800;
+constexpr uint32_t HIGH_SURROGATE_MAX = 0xDBFF;
+constexpr uint32_t LOW_SURROGATE_MIN = 0xDC00;
+constexpr uint32_t LOW_SURROGATE_MAX = 0xDFFF;
+constexpr uint32_t SURROGATE_BITS = 10;
+constexpr uint32_t SURROGATE_MASK = 0x3FF;
+constexpr uint32_t SUPPLEMENTARY_MIN = 0x10000;
+
+bool ParseHex(const char *pos, const char *end, uint32_t &code)
+{
+    constexpr size_t hexLen = 4;
+    constexpr uint32_t hexBase = 16;
+    constexpr uint32_t hexAlphaBase = 10;
+    if (end - pos < static_cast<ptrdiff_t>(hexLen)) {
+        return false;
+    }
+    code = 0;
+    for (size_t i = 0; i < hexLen; i++) {
+        char c = pos[i];
+        uint32_t digit = 0;
+        if (c >= '0' && c <= '9') {
+            digit = static_cast<uint32_t>(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            digit = static_cast<uint32_t>(c - 'a') + hexAlphaBase;
+        } else if (c >= 'A' && c <= 'F') {
+            digit = static_cast<uint32_t>(c - 'A') + hexAlphaBase;
+        } else {
+            return false;
+        }
+        code = code * hexBase + digit;
+    }
+    return true;
+}
+
+char *EncodeUtf8(uint32_t code, char *out)
+{
+    if (code < 0x80) {
+        *out++ = static_cast<char>(code);
+    } else if (code < 0x800) {
+        *out++ = static_cast<char>(0xC0 | (code >> 6));
+        *out++ = static_cast<char>(0x80 | (code & 0x3F));
+    } else if (code < SUPPLEMENTARY_MIN) {
+        *out++ = static_cast<char>(0xE0 | (code >> 12));
+        *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (code & 0x3F));
+    } else {
+        *out++ = static_cast<char>(0xF0 | (code >> 18));
+        *out++ = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+        *out++ = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (code & 0x3F));
+    }
+    return out;
+}
+
+bool IsDigit(const char *pos, const char *end)
+{
+    return pos < end && *pos >= '0' && *pos <= '9';
+}
+}
+
+JsonDocument::~JsonDocument()
+{
+    Reset();
+}
+
+bool JsonDocument::Load(const string &path)
+{
+    Reset();
+    MappedFile file;
+    isArena_ = true;
+    if (file.Open(path, false) && Parse(file.GetData(), file.GetSize())) {
+        return true;
+    }
+    // not strict json or not readable, cJSON decides and reports the error
+    Reset();
+    return ResourceUtil::OpenJsonFile(path, &root_);
+}
+
+cJSON *JsonDocument::GetRoot() const
+{
+    return root_;
+}
+
+// below private
+bool JsonDocument::Parse(const char *data, size_t length)
+{
+    pos_ = data;
+    end_ = data + length;
+    if (length >= UTF8_BOM_LEN && memcmp(data, UTF8_BOM, UTF8_BOM_LEN) == 0) {
+        pos_ += UTF8_BOM_LEN;
+    }
+    root_ = NewNode();
+    if (root_ == nullptr) {
+        return false;
+    }
+    SkipWhitespace();
+    if (!ParseValue(root_, 0)) {
+        return false;
+    }
+    SkipWhitespace();
+    return pos_ == end_;
+}
+
+bool JsonDocument::ParseValue(cJSON *node, size_t depth)
+{
+    if (pos_ >= end_) {
+        return false;
+    }
+    switch (*pos_) {
+        case '"':
+            node->type = cJSON_String;
+            return ParseString(node->valuestring);
+        case '[':
+            return ParseArray(node, depth + 1);
+        case '{':
+            return ParseObject(node, depth + 1);
+        case 't':
+            node->type = cJSON_True;
+            node->valueint = 1;
+            return ParseLiteral("true", strlen("true"));
+        case 'f':
+            node->type = cJSON_False;
+            return ParseLiteral("false", strlen("false"));
+        case 'n':
+            node->type = cJSON_NULL;
+            return ParseLiteral("null", strlen("null"));
+        default:
+            return ParseNumber(node);
+    }
+}
+
+bool JsonDocument::ParseString(char *&value)
+{
+    // the decoded string is never longer than the raw one
+    const char *start = ++pos_;
+    const char *end = start;
+    bool escaped = false;
+    while (end < end_ && *end != '"') {
+        if (static_cast<unsigned char>(*end) < ' ') {
+            return false;
+        }
+        if (*end == '\\') {
+            escaped = true;
+            end++;
+        }
+        end++;
+    }
+    if (end >= end_) {
+        return false;
+    }
+    value = static_cast<char *>(Allocate(end - start + 1));
+    if (value == nullptr) {
+        return false;
+    }
+    pos_ = end + 1;
+    if (!escaped) {
+        memcpy(value, start, end - start);
+        value[end - start] = '\0';
+        return true;
+    }
+
+    char *out = value;
+    for (const char *pos = start; pos < end;) {
+        if (*pos != '\\') {
+            *out++ = *pos++;
+            continue;
+        }
+        pos++;
+        switch (*pos++) {
+            case '"':
+            case '\\':
+            case '/':
+                *out++ = pos[-1];
+                break;
+            case 'b':
+                *out++ = '\b';
+                break;
+            case 'f':
+                *out++ = '\f';
+                break;
+            case 'n':
+                *out++ = '\n';
+                break;
+            case 'r':
+                *out++ = '\r';
+                break;
+            case 't':
+                *out++ = '\t';
+                break;
+            case 'u': {
+                uint32_t code = 0;
+                uint32_t low = 0;
+                // cJSON truncates a string at \u0000, such strings are left to it
+                if (!ParseHex(pos, end, code) || code == 0 ||
+                    (code >= LOW_SURROGATE_MIN && code <= LOW_SURROGATE_MAX)) {
+                    return false;
+                }
+                pos += strlen("0000");
+                if (code >= HIGH_SURROGATE_MIN && code <= HIGH_SURROGATE_MAX) {
+                    if (end - pos < static_cast<ptrdiff_t>(strlen("\\u")) || pos[0] != '\\' || pos[1] != 'u' ||
+                        !ParseHex(pos + strlen("\\u"), end, low) || low < LOW_SURROGATE_MIN ||
+                        low > LOW_SURROGATE_MAX) {
+                        return false;
+                    }
+                    pos += strlen("\\u0000");
+                    code = SUPPLEMENTARY_MIN + (((code & SURROGATE_MASK) << SURROGATE_BITS) | (low & SURROGATE_MASK));
+                }
+                out = EncodeUtf8(code, out);
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    *out = '\0';
+    return true;
+}
+
+bool JsonDocument::ParseNumber(cJSON *node)
+{
+    const char *start = pos_;
+    if (*pos_ == '-') {
+        pos_++;
+    }
+    if (!IsDigit(pos_, end_)) {
+        return false;
+    }
+    if (*pos_ == '0') {
+        pos_++;
+    } else {
+        while (IsDigit(pos_, end_)) {
+            pos_++;
+        }
+    }
+    if (pos_ < end_ && *pos_ == '.') {
+        pos_++;
+        if (!IsDigit(pos_, end_)) {
+            return false;
+        }
+        while (IsDigit(pos_, end_)) {
+            pos_++;
+        }
+    }
+    if (pos_ < end_ && (*pos_ == 'e' || *pos_ == 'E')) {
+        pos_++;
+        if (pos_ < end_ && (*pos_ == '+' || *pos_ == '-')) {
+            pos_++;
+        }
+        if (!IsDigit(pos_, end_)) {
+            return false;
+        }
+        while (IsDigit(pos_, end_)) {
+            pos_++;
+        }
+    }
+    size_t length = static_cast<size_t>(pos_ - start);
+    if (length >= NUMBER_MAX_LEN) {
+        return false;
+    }
+    char number[NUMBER_MAX_LEN];
+    memcpy(number, start, length);
+    number[length] = '\0';
+    double value = strtod(number, nullptr);
+    // same saturation as cJSON
+    node->type = cJSON_Number;
+    node->valuedouble = value;
+    if (value >= INT_MAX) {
+        node->valueint = INT_MAX;
+    } else if (value <= static_cast<double>(INT_MIN)) {
+        node->valueint = INT_MIN;
+    } else {
+        node->valueint = static_cast<int>(value);
+    }
+    return true;
+}
+
+bool JsonDocument::ParseArray(cJSON *node, size_t depth)
+{
+    if (depth > MAX_DEPTH) {
+        return false;
+    }
+    node->type = cJSON_Array;
+    pos_++;
+    SkipWhitespace();
+    if (pos_ < end_ && *pos_ == ']') {
+        pos_++;
+        return true;
+    }
+    cJSON *last = nullptr;
+    while (true) {
+        cJSON *item = NewNode();
+        if (item == nullptr) {
+            return false;
+        }
+        // linked as cJSON does, the prev of the first child is the last child
+        if (last == nullptr) {
+            node->child = item;
+        } else {
+            last->next = item;
+            item->prev = last;
+        }
+        last = item;
+        node->child->prev = last;
+        SkipWhitespace();
+        if (!ParseValue(item, depth)) {
+            return false;
+        }
+        SkipWhitespace();
+        if (pos_ >= end_) {
+            return false;
+        }
+        if (*pos_ == ']') {
+            pos_++;
+            return true;
+        }
+        if (*pos_ != ',') {
+            return false;
+        }
+        pos_++;
+    }
+}
+
+bool JsonDocument::ParseObject(cJSON *node, size_t depth)
+{
+    if (depth > MAX_DEPTH) {
+        return false;
+    }
+    node->type = cJSON_Object;
+    pos_++;
+    SkipWhitespace();
+    if (pos_ < end_ && *pos_ == '}') {
+        pos_++;
+        return true;
+    }
+    cJSON *last = nullptr;
+    while (true) {
+        cJSON *item = NewNode();
+        if (item == nullptr) {
+            return false;
+        }
+        if (last == nullptr) {
+            node->child = item;
+        } else {
+            last->next = item;
+            item->prev = last;
+        }
+        last = item;
+        node->child->prev = last;
+        SkipWhitespace();
+        if (pos_ >= end_ || *pos_ != '"' || !ParseString(item->string)) {
+            return false;
+        }
+        SkipWhitespace();
+        if (pos_ >= end_ || *pos_ != ':') {
+            return false;
+        }
+        pos_++;
+        SkipWhitespace();
+        if (!ParseValue(item, depth)) {
+            return false;
+        }
+        SkipWhitespace();
+        if (pos_ >= end_) {
+            return false;
+        }
+        if (*pos_ == '}') {
+            pos_++;
+            return true;
+        }
+        if (*pos_ != ',') {
+            return false;
+        }
+        pos_++;
+    }
+}
+
+bool JsonDocument::ParseLiteral(const char *literal, size_t length)
+{
+    if (static_cast<size_t>(end_ - pos_) < length || memcmp(pos_, literal, length) != 0) {
+        return false;
+    }
+    pos_ += length;
+    return true;
+}
+
+void JsonDocument::SkipWhitespace()
+{
+    while (pos_ < end_ && (*pos_ == ' ' || *pos_ == '\n' || *pos_ == '\r' || *pos_ == '\t')) {
+        pos_++;
+    }
+}
+
+cJSON *JsonDocument::NewNode()
+{
+    cJSON *node = static_cast<cJSON *>(Allocate(sizeof(cJSON)));
+    if (node != nullptr) {
+        memset(node, 0, sizeof(cJSON));
+    }
+    return node;
+}
+
+void *JsonDocument::Allocate(size_t size)
+{
+    // nodes and strings share the blocks, every allocation is aligned for a node
+    size = (size + alignof(cJSON) - 1) / alignof(cJSON) * alignof(cJSON);
+    if (size > blockFree_) {
+        size_t blockSize = max(size, BLOCK_SIZE);
+        unique_ptr<char[]> block(new (nothrow) char[blockSize]);
+        if (block == nullptr) {
+            return nullptr;
+        }
+        blockPos_ = block.get();
+        blockFree_ = blockSize;
+        blocks_.push_back(move(block));
+    }
+    void *ret = blockPos_;
+    blockPos_ += size;
+    blockFree_ -= size;
+    return ret;
+}
+
+void JsonDocument::Reset()
+{
+    if (root_ != nullptr && !isArena_) {
+        cJSON_Delete(root_);
+    }
+    root_ = nullptr;
+    isArena_ = false;
+    blocks_.clear();
+    blockPos_ = nullptr;
+    blockFree_ = 0;
+    pos_ = nullptr;
+    end_ = nullptr;
+}
+}
+}
+}
@@ -14,6 +14,7 @@
  */
 
 #include "key_parser.h"
+#include <mutex>
 #include <regex>
 #include "resource_util.h"
 
@@ -21,21 +22,33 @@ namespace OHOS {
 namespace Global {
 namespace Restool {
 using namespace std;
-map<string, vector<KeyParam>> KeyParser::caches_ = {};
+unordered_map<string, shared_ptr<const vector<KeyParam>>> KeyParser::caches_;
+shared_mutex KeyParser::cachesMutex_;
 bool KeyParser::Parse(const string &folderName, vector<KeyParam> &keyparams)
 {
     if (folderName == "base") {
         return true;
     }
 
-    if (caches_.count(folderName) != 0) {
-        keyparams = caches_[folderName];
-        return true;
+    auto result = Parse(folderName);
+    if (result == nullptr) {
+        return false;
+    }
+    keyparams = *result;
+    return true;
+}
+
+shared_ptr<const vector<KeyParam>> KeyParser::Parse(const string &folderName)
+{
+    {
+        shared_lock<shared_mutex> lock(cachesMutex_);
+        auto it = caches_.find(folderName);
+        if (it != caches_.end()) {
+            return it->second;
+        }
     }
-    vector<string> keyParts;
-    ResourceUtil::Split(folderName, keyParts, "-");
 
-    vector<parse_key_founction> founctions = {
+    static const vector<parse_key_founction> founctions = {
         ParseMccMnc,
         ParseLSR,
         ParseOrientation,
@@ -45,11 +58,21 @@ bool KeyParser::Parse(const string &folderName, vector<KeyParam> &keyparams)
         ParseResolution,
     };
 
-    if (!ParseMatch(keyParts, keyparams, founctions)) {
-        return false;
+    shared_ptr<const vector<KeyParam>> result;
+    vector<KeyParam> keyparams;
+    if (folderName == "base") {
+        result = make_shared<const vector<KeyParam>>();
+    } else {
+        vector<string> keyParts;
+        ResourceUtil::Split(folderName, keyParts, "-");
+        if (ParseMatch(keyParts, keyparams, founctions)) {
+            result = make_shared<const vector<KeyParam>>(move(keyparams));
+        }
     }
-    caches_.emplace(folderName, keyparams);
-    return true;
+
+    // another thread may have parsed the same folder name, the first result is kept
+    unique_lock<shared_mutex> lock(cachesMutex_);
+    return caches_.emplace(folderName, move(result)).first->second;
 }
 
 bool KeyParser::ParseMatch(const vector<string> &keys,
@@ -117,7 +140,7 @@ bool KeyParser::ParseMatchBySeq(const vector<string> &keys,
 
 bool KeyParser::ParseMccMnc(const string &folderName, vector<KeyParam> &keyparams)
 {
-    vector<parse_key_founction> founctions = {
+    static const vector<parse_key_founction> founctions = {
         ParseMcc,
         ParseMnc,
     };
@@ -132,7 +155,7 @@ bool KeyParser::ParseMccMnc(const string &folderName, vector<KeyParam> &keyparam
 
 bool KeyParser::ParseMcc(const string &folderName, vector<KeyParam> &keyparams)
 {
-    regex mcc("mcc(\\d{3})");
+    static const regex mcc("mcc(\\d{3})");
     if (!regex_match(folderName, mcc)) {
         return false;
     }
@@ -143,7 +166,7 @@ bool KeyParser::ParseMcc(const string &folderName, vector<KeyParam> &keyparams)
 
 bool KeyParser::ParseMnc(const string &folderName, vector<KeyParam> &keyparams)
 {
-    regex mcc("mnc(\\d{2,3})");
+    static const regex mcc("mnc(\\d{2,3})");
     if (!regex_match(folderName, mcc)) {
         return false;
     }
@@ -154,7 +177,7 @@ bool KeyParser::ParseMnc(const string &folderName, vector<KeyParam> &keyparams)
 
 bool KeyParser::ParseLSR(const string &folderName, vector<KeyParam> &keyparams)
 {
-    map<string, vector<parse_key_founction>> founctionModels = {
+    static const map<string, vector<parse_key_founction>> founctionModels = {
         { "all", { ParseLanguage, ParseScript, ParseRegion } },
         { "language script", { ParseLanguage, ParseScript} },
         { "language region", { ParseLanguage, ParseRegion } },
@@ -162,11 +185,11 @@ bool KeyParser::ParseLSR(const string &folderName, vector<KeyParam> &keyparams)
 
     vector<string> keyParts;
     ResourceUtil::Split(folderName, keyParts, "_");
-    if (keyParts.size() > founctionModels["all"].size()) {
+    if (keyParts.size() > founctionModels.at("all").size()) {
         return false;
     }
 
-    for (auto model : founctionModels) {
+    for (const auto &model : founctionModels) {
         vector<KeyParam> tmp;
         if (ParseMatchBySeq(keyParts, tmp, model.second)) {
             keyparams.insert(keyparams.end(), tmp.begin(), tmp.end());
@@ -182,7 +205,7 @@ bool KeyParser::ParseLanguage(const string &folderName, vector<KeyParam> &keypar
         return false;
     }
 
-    regex language("[a-z]{2,3}");
+    static const regex language("[a-z]{2,3}");
     if (!regex_match(folderName, language)) {
         return false;
     }
@@ -197,7 +220,7 @@ bool KeyParser::ParseScript(const string &folderName, vector<KeyParam> &keyparam
         return false;
     }
 
-    regex script("^[A-Z][a-z]{3}");
+    static const regex script("^[A-Z][a-z]{3}");
     if (!regex_match(folderName, script)) {
         return false;
     }
@@ -212,8 +235,8 @@ bool KeyParser::ParseRegion(const string &folderName, vector<KeyParam> &keyparam
         return false;
     }
 
-    regex regionOfNumber("[0-9]{3}");
-    regex regionOfSupper("[A-Z]{2,3}");
+    static const regex regionOfNumber("[0-9]{3}");
+    static const regex regionOfSupper("[A-Z]{2,3}");
 
     if (!regex_match(folderName, regionOfNumber) && !regex_match(folderName, regionOfSupper)) {
         return false;
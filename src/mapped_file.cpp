@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "mapped_file.h"
+#include <cerrno>
+#include <cstring>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "restool_errors.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+using namespace std;
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+#ifdef _WIN32
+bool MappedFile::Open(const string &path, bool printError)
+{
+    Close();
+    hFile_ = CreateFile(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_READONLY | FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (hFile_ == INVALID_HANDLE_VALUE) {
+        if (printError) {
+            PrintError(GetError(ERR_CODE_OPEN_FILE_ERROR).FormatCause(path.c_str(), to_string(GetLastError()).c_str()));
+        }
+        return false;
+    }
+    DWORD fileSize = GetFileSize(hFile_, nullptr);
+    if (fileSize == 0 || fileSize == INVALID_FILE_SIZE) {
+        if (printError) {
+            PrintError(GetError(ERR_CODE_READ_FILE_ERROR).FormatCause(path.c_str(), "file is empty"));
+        }
+        Close();
+        return false;
+    }
+    hFileMap_ = CreateFileMapping(hFile_, nullptr, PAGE_READONLY, 0, fileSize, nullptr);
+    if (hFileMap_ == nullptr) {
+        string errMsg = "create mapping error: " + to_string(GetLastError());
+        if (printError) {
+            PrintError(GetError(ERR_CODE_READ_FILE_ERROR).FormatCause(path.c_str(), errMsg.c_str()));
+        }
+        Close();
+        return false;
+    }
+    void *buffer = MapViewOfFile(hFileMap_, FILE_MAP_READ, 0, 0, 0);
+    if (buffer == nullptr) {
+        string errMsg = "map view of file error: " + to_string(GetLastError());
+        if (printError) {
+            PrintError(GetError(ERR_CODE_READ_FILE_ERROR).FormatCause(path.c_str(), errMsg.c_str()));
+        }
+        Close();
+        return false;
+    }
+    data_ = reinterpret_cast<const char *>(buffer);
+    size_ = fileSize;
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (data_ != nullptr) {
+        UnmapViewOfFile(data_);
+        data_ = nullptr;
+    }
+    if (hFileMap_ != nullptr) {
+        CloseHandle(hFileMap_);
+        hFileMap_ = nullptr;
+    }
+    if (hFile_ != INVALID_HANDLE_VALUE) {
+        CloseHandle(hFile_);
+        hFile_ = INVALID_HANDLE_VALUE;
+    }
+    size_ = 0;
+}
+#else
+bool MappedFile::Open(const string &path, bool printError)
+{
+    Close();
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        if (printError) {
+            PrintError(GetError(ERR_CODE_OPEN_FILE_ERROR).FormatCause(path.c_str(), strerror(errno)));
+        }
+        return false;
+    }
+    struct stat s;
+    if (fstat(fd, &s) != 0) {
+        if (printError) {
+            PrintError(GetError(ERR_CODE_READ_FILE_ERROR).FormatCause(path.c_str(), strerror(errno)));
+        }
+        close(fd);
+        return false;
+    }
+    if (s.st_size <= 0) {
+        if (printError) {
+            PrintError(GetError(ERR_CODE_READ_FILE_ERROR).FormatCause(path.c_str(), "file is empty"));
+        }
+        close(fd);
+        return false;
+    }
+    void *buffer = mmap(nullptr, static_cast<size_t>(s.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (buffer == MAP_FAILED) {
+        if (printError) {
+            PrintError(GetError(ERR_CODE_READ_FILE_ERROR).FormatCause(path.c_str(), strerror(errno)));
+        }
+        close(fd);
+        return false;
+    }
+    // the mapping stays valid after the descriptor is closed
+    close(fd);
+    data_ = reinterpret_cast<const char *>(buffer);
+    size_ = static_cast<size_t>(s.st_size);
+    return true;
+}
+
+void MappedFile::Close()
+{
+    if (data_ != nullptr) {
+        munmap(const_cast<char *>(data_), size_);
+        data_ = nullptr;
+    }
+    size_ = 0;
+}
+#endif
+
+const char *MappedFile::GetData() const
+{
+    return data_;
+}
+
+size_t MappedFile::GetSize() const
+{
+    return size_;
+}
+}
+}
+}
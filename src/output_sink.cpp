@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "output_sink.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <vector>
+#include "file_entry.h"
+#include "resource_data.h"
+#include "restool_errors.h"
+#include "thread_pool.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+using namespace std;
+constexpr size_t COMPARE_BUFFER_SIZE = 64 * 1024;
+const string OUTPUT_MANIFEST_FILE = ".restool_output_manifest";
+const string OUTPUT_MANIFEST_VERSION = "restool output manifest 1";
+
+bool OutputSink::Write(const string &path, const char *data, size_t length)
+{
+    size_t written = 0;
+    return Write(path, data, length, written);
+}
+
+bool OutputSink::Write(const string &path, const string &content)
+{
+    return Write(path, content.data(), content.length());
+}
+
+bool OutputSink::Write(const string &path, const char *data, size_t length, size_t &written)
+{
+    written = 0;
+    if (IsSame(path, data, length)) {
+        Count(length, true);
+        Record(path);
+        return true;
+    }
+    ofstream out(FileEntry::AdaptLongPath(path), ofstream::out | ofstream::binary);
+    if (!out.is_open()) {
+        PrintError(GetError(ERR_CODE_OPEN_FILE_ERROR).FormatCause(path.c_str(), strerror(errno)));
+        return false;
+    }
+    out.write(data, length);
+    out.close();
+    if (!out) {
+        PrintError(GetError(ERR_CODE_CREATE_FILE_ERROR).FormatCause(path.c_str(), strerror(errno)));
+        return false;
+    }
+    Count(length, false);
+    Record(path);
+    written = length;
+    return true;
+}
+
+bool OutputSink::Copy(const string &src, const string &dst)
+{
+    uint64_t size = 0;
+    if (IsSame(src, dst, size)) {
+        Count(size, true);
+        Record(dst);
+        return true;
+    }
+    if (!FileEntry::CopyFileInner(src, dst)) {
+        return false;
+    }
+    Count(size, false);
+    Record(dst);
+    return true;
+}
+
+void OutputSink::Keep(const string &path)
+{
+    Record(path);
+}
+
+bool OutputSink::LoadManifest(const string &output, bool record)
+{
+    output_ = FileEntry::FilePath(output).GetPath();
+    resourcesPrefix_ = FileEntry::FilePath(output).Append(RESOURCES_DIR).GetPath() + SEPARATOR_FILE;
+    manifestPath_ = FileEntry::FilePath(output).Append(OUTPUT_MANIFEST_FILE).GetPath();
+    recording_ = record;
+    lastFiles_.clear();
+    files_.clear();
+    ifstream in(FileEntry::AdaptLongPath(manifestPath_), ifstream::in | ifstream::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    string line;
+    bool loaded = getline(in, line) && line == OUTPUT_MANIFEST_VERSION;
+    while (loaded && getline(in, line)) {
+        if (!line.empty()) {
+            lastFiles_.insert(line);
+        }
+    }
+    in.close();
+    // a build that fails leaves no manifest, the next build then removes the whole resources directory
+    if (remove(FileEntry::AdaptLongPath(manifestPath_).c_str()) != 0) {
+        lastFiles_.clear();
+        return false;
+    }
+    if (!loaded || !record) {
+        lastFiles_.clear();
+        return false;
+    }
+    // a file the manifest does not list, such as one put there by hand, would survive the reconcile but not a
+    // clean build, then the resources directory is removed as a whole
+    string resourcesDir = resourcesPrefix_.substr(0, resourcesPrefix_.size() - SEPARATOR_FILE.size());
+    if (FileEntry::Exist(resourcesDir) && !IsListed(FileEntry(resourcesDir))) {
+        lastFiles_.clear();
+        return false;
+    }
+    return true;
+}
+
+uint32_t OutputSink::Reconcile()
+{
+    if (!recording_) {
+        return RESTOOL_SUCCESS;
+    }
+    recording_ = false;
+    vector<string> staleFiles;
+    for (const auto &file : lastFiles_) {
+        if (files_.count(file) == 0) {
+            staleFiles.push_back(file);
+        }
+    }
+    if (RemoveStaleFiles(staleFiles) != RESTOOL_SUCCESS) {
+        return RESTOOL_ERROR;
+    }
+
+    vector<string> files(files_.begin(), files_.end());
+    sort(files.begin(), files.end());
+    string buffer = OUTPUT_MANIFEST_VERSION + "\n";
+    for (const auto &file : files) {
+        buffer.append(file).append("\n");
+    }
+    ofstream out(FileEntry::AdaptLongPath(manifestPath_), ofstream::out | ofstream::binary);
+    if (!out.is_open()) {
+        PrintError(GetError(ERR_CODE_OPEN_FILE_ERROR).FormatCause(manifestPath_.c_str(), strerror(errno)));
+        return RESTOOL_ERROR;
+    }
+    out.write(buffer.c_str(), buffer.size());
+    if (!out.good()) {
+        PrintError(GetError(ERR_CODE_CREATE_FILE_ERROR).FormatCause(manifestPath_.c_str(), strerror(errno)));
+        return RESTOOL_ERROR;
+    }
+    return RESTOOL_SUCCESS;
+}
+
+void OutputSink::PrintStatistics() const
+{
+    if (writtenFiles_ == 0 && skippedFiles_ == 0) {
+        return;
+    }
+    cout << "Info: output files: " << writtenFiles_ << " written (" << writtenBytes_ << " bytes), ";
+    cout << skippedFiles_ << " unchanged and skipped (" << skippedBytes_ << " bytes)." << endl;
+}
+
+// below private
+bool OutputSink::IsSame(const string &path, const char *data, size_t length)
+{
+    // the sizes are compared first, the content is compared only when the sizes are equal
+    ifstream in(FileEntry::AdaptLongPath(path), ifstream::in | ifstream::binary | ifstream::ate);
+    if (!in.is_open() || static_cast<uint64_t>(in.tellg()) != length) {
+        return false;
+    }
+    in.seekg(0, in.beg);
+    vector<char> buffer(min(length, COMPARE_BUFFER_SIZE));
+    for (size_t pos = 0; pos < length;) {
+        size_t count = min(buffer.size(), length - pos);
+        if (!in.read(buffer.data(), count) || memcmp(buffer.data(), data + pos, count) != 0) {
+            return false;
+        }
+        pos += count;
+    }
+    return true;
+}
+
+bool OutputSink::IsSame(const string &src, const string &dst, uint64_t &size)
+{
+    ifstream srcIn(FileEntry::AdaptLongPath(src), ifstream::in | ifstream::binary | ifstream::ate);
+    if (!srcIn.is_open()) {
+        return false;
+    }
+    size = static_cast<uint64_t>(srcIn.tellg());
+    ifstream dstIn(FileEntry::AdaptLongPath(dst), ifstream::in | ifstream::binary | ifstream::ate);
+    if (!dstIn.is_open() || static_cast<uint64_t>(dstIn.tellg()) != size) {
+        return false;
+    }
+    srcIn.seekg(0, srcIn.beg);
+    dstIn.seekg(0, dstIn.beg);
+    vector<char> srcBuffer(COMPARE_BUFFER_SIZE);
+    vector<char> dstBuffer(COMPARE_BUFFER_SIZE);
+    for (uint64_t pos = 0; pos < size;) {
+        size_t count = static_cast<size_t>(min<uint64_t>(COMPARE_BUFFER_SIZE, size - pos));
+        if (!srcIn.read(srcBuffer.data(), count) || !dstIn.read(dstBuffer.data(), count) ||
+            memcmp(srcBuffer.data(), dstBuffer.data(), count) != 0) {
+            return false;
+        }
+        pos += count;
+    }
+    return true;
+}
+
+bool OutputSink::IsListed(const FileEntry &dir) const
+{
+    auto children = dir.GetChilds();
+    if (children.empty()) {
+        // no build leaves an empty directory, the stale ones are removed with their last file
+        return false;
+    }
+    for (const auto &child : children) {
+        if (child->IsFile()) {
+            string file = child->GetFilePath().GetPath().substr(output_.size() + SEPARATOR_FILE.size());
+            if (lastFiles_.count(file) == 0) {
+                return false;
+            }
+        } else if (!IsListed(*child)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void OutputSink::Record(const string &path)
+{
+    if (!recording_ || path.compare(0, resourcesPrefix_.size(), resourcesPrefix_) != 0) {
+        return;
+    }
+    string file = path.substr(output_.size() + SEPARATOR_FILE.size());
+    lock_guard<mutex> lock(filesMutex_);
+    files_.insert(move(file));
+}
+
+uint32_t OutputSink::RemoveStaleFiles(const vector<string> &staleFiles) const
+{
+    if (staleFiles.empty()) {
+        return RESTOOL_SUCCESS;
+    }
+    string resourcesDir = resourcesPrefix_.substr(0, resourcesPrefix_.size() - SEPARATOR_FILE.size());
+    uint32_t ret = ThreadPool::GetInstance().ParallelFor(staleFiles.size(), [this, &staleFiles](size_t i) {
+        string path = output_ + SEPARATOR_FILE + staleFiles[i];
+        if (FileEntry::Exist(path) && !FileEntry::RemoveFile(path)) {
+            return RESTOOL_ERROR;
+        }
+        return RESTOOL_SUCCESS;
+    });
+    if (ret != RESTOOL_SUCCESS) {
+        return RESTOOL_ERROR;
+    }
+
+    // the directories left empty are removed too, a child path is longer than its parent so it goes first
+    set<string> dirs;
+    for (const auto &file : staleFiles) {
+        string dir = FileEntry::FilePath(output_ + SEPARATOR_FILE + file).GetParent().GetPath();
+        while (dir.size() > resourcesDir.size() && dirs.insert(dir).second) {
+            dir = FileEntry::FilePath(dir).GetParent().GetPath();
+        }
+    }
+    vector<string> sortedDirs(dirs.begin(), dirs.end());
+    stable_sort(sortedDirs.begin(), sortedDirs.end(), [](const string &a, const string &b) {
+        return a.size() > b.size();
+    });
+    for (const auto &dir : sortedDirs) {
+        FileEntry::RemoveEmptyDir(dir);
+    }
+    cout << "Info: output files: " << staleFiles.size() << " files of the last build are removed." << endl;
+    return RESTOOL_SUCCESS;
+}
+
+void OutputSink::Count(uint64_t size, bool skipped)
+{
+    if (skipped) {
+        skippedFiles_++;
+        skippedBytes_ += size;
+    } else {
+        writtenFiles_++;
+        writtenBytes_ += size;
+    }
+}
+}
+}
+}
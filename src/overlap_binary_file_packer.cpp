@@ -14,6 +14,7 @@
  */
 
 #include "overlap_binary_file_packer.h"
+#include "sharded_set.h"
 
 namespace OHOS {
 namespace Global {
@@ -44,8 +45,8 @@ uint32_t OverlapBinaryFilePacker::CopyBinaryFile(const vector<string> &inputs)
 
 bool OverlapBinaryFilePacker::IsDuplicated(const unique_ptr<FileEntry> &entry, string subPath)
 {
-    lock_guard<mutex> lock(mutex_);
-    if (!g_hapResourceSet.emplace(subPath).second || !g_resourceSet.emplace(subPath).second) {
+    ShardedSet::Key key = ShardedSet::MakeKey(move(subPath));
+    if (!g_hapResourceSet.Insert(key) || !g_resourceSet.Insert(key)) {
         cout << "Warning: '" << entry->GetFilePath().GetPath() << "' is defined repeatedly in hap." << endl;
         return true;
     }
@@ -14,74 +14,84 @@
  */
 
 #include "reference_parser.h"
+#include <atomic>
 #include <iostream>
-#include <regex>
 #include "file_entry.h"
 #include "restool_errors.h"
+#include "thread_pool.h"
 
 namespace OHOS {
 namespace Global {
 namespace Restool {
 using namespace std;
-const map<string, ResType> ReferenceParser::ID_REFS = {
-    { "^\\$id:", ResType::ID },
-    { "^\\$boolean:", ResType::BOOLEAN },
-    { "^\\$color:", ResType::COLOR },
-    { "^\\$float:", ResType::FLOAT },
-    { "^\\$media:", ResType::MEDIA },
-    { "^\\$profile:", ResType::PROF },
-    { "^\\$integer:", ResType::INTEGER },
-    { "^\\$string:", ResType::STRING },
-    { "^\\$pattern:", ResType::PATTERN },
-    { "^\\$plural:", ResType::PLURAL },
-    { "^\\$theme:", ResType::THEME },
-    { "^\\$symbol:", ResType::SYMBOL }
-};
-
-const map<string, ResType> ReferenceParser::ID_OHOS_REFS = {
-    { "^\\$ohos:id:", ResType::ID },
-    { "^\\$ohos:boolean:", ResType::BOOLEAN },
-    { "^\\$ohos:color:", ResType::COLOR },
-    { "^\\$ohos:float:", ResType::FLOAT },
-    { "^\\$ohos:media:", ResType::MEDIA },
-    { "^\\$ohos:profile:", ResType::PROF },
-    { "^\\$ohos:integer:", ResType::INTEGER },
-    { "^\\$ohos:string:", ResType::STRING },
-    { "^\\$ohos:pattern:", ResType::PATTERN },
-    { "^\\$ohos:plural:", ResType::PLURAL },
-    { "^\\$ohos:theme:", ResType::THEME },
-    { "^\\$ohos:symbol:", ResType::SYMBOL }
+const map<string, ResType, less<>> ReferenceParser::REF_TYPES = {
+    { "id", ResType::ID },
+    { "boolean", ResType::BOOLEAN },
+    { "color", ResType::COLOR },
+    { "float", ResType::FLOAT },
+    { "media", ResType::MEDIA },
+    { "profile", ResType::PROF },
+    { "integer", ResType::INTEGER },
+    { "string", ResType::STRING },
+    { "pattern", ResType::PATTERN },
+    { "plural", ResType::PLURAL },
+    { "theme", ResType::THEME },
+    { "symbol", ResType::SYMBOL }
 };
+const string OHOS_REF_PREFIX = "$ohos:";
 
 std::map<int64_t, std::set<int64_t>> ReferenceParser::layerIconIds_;
 
-ReferenceParser::ReferenceParser() : idWorker_(IdWorker::GetInstance()), root_(nullptr), isParsingMediaJson_(false)
+ReferenceParser::ReferenceParser() : idWorker_(IdWorker::GetInstance()), mediaLayerIcons_(nullptr)
 {
 }
 
 ReferenceParser::~ReferenceParser()
 {
-    if (root_) {
-        cJSON_Delete(root_);
-    }
 }
 
 uint32_t ReferenceParser::ParseRefInResources(map<int64_t, vector<ResourceItem>> &items, const string &output)
 {
+    vector<ResourceItem *> refItems;
     for (auto &iter : items) {
         for (auto &resourceItem : iter.second) {
             if (resourceItem.IsCoverable()) {
                 continue;
             }
-            if (IsElementRef(resourceItem) && ParseRefInResourceItem(resourceItem) != RESTOOL_SUCCESS) {
-                return RESTOOL_ERROR;
-            }
-            if ((IsMediaRef(resourceItem) || IsProfileRef(resourceItem)) &&
-                ParseRefInJsonFile(resourceItem, output) != RESTOOL_SUCCESS) {
-                return RESTOOL_ERROR;
+            if (IsElementRef(resourceItem) || IsMediaRef(resourceItem) || IsProfileRef(resourceItem)) {
+                refItems.push_back(&resourceItem);
             }
         }
     }
+
+    // the items after the first failed one are skipped, the failed one is the first in item order once all done
+    vector<RefResult> results(refItems.size());
+    atomic<size_t> firstFailed(refItems.size());
+    ThreadPool::GetInstance().ParallelFor(refItems.size(), [&refItems, &output, &results, &firstFailed](size_t i) {
+        if (i > firstFailed) {
+            return RESTOOL_SUCCESS;
+        }
+        ReferenceParser referenceParser;
+        string *lastBuffer = SetErrorBuffer(&results[i].errors);
+        uint32_t ret = referenceParser.ParseRefInItem(*refItems[i], output, results[i]);
+        SetErrorBuffer(lastBuffer);
+        if (ret != RESTOOL_SUCCESS) {
+            results[i].success = false;
+            size_t failed = firstFailed;
+            while (i < failed && !firstFailed.compare_exchange_weak(failed, i)) {}
+        }
+        return ret;
+    });
+
+    for (auto &result : results) {
+        if (!result.success) {
+            PrintErrors(result.errors);
+            return RESTOOL_ERROR;
+        }
+        for (auto &layerIcon : result.layerIconIds) {
+            layerIconIds_[layerIcon.first] = move(layerIcon.second);
+        }
+    }
     return RESTOOL_SUCCESS;
 }
 
@@ -120,6 +130,39 @@ uint32_t ReferenceParser::ParseRefInResourceItem(ResourceItem &resourceItem) con
 }
 
 uint32_t ReferenceParser::ParseRefInJsonFile(ResourceItem &resourceItem, const string &output, const bool isIncrement)
+{
+    map<int64_t, set<int64_t>> layerIconIds;
+    if (ParseRefInJsonFile(resourceItem, output, isIncrement, layerIconIds) != RESTOOL_SUCCESS) {
+        return RESTOOL_ERROR;
+    }
+    for (auto &layerIcon : layerIconIds) {
+        layerIconIds_[layerIcon.first] = move(layerIcon.second);
+    }
+    return RESTOOL_SUCCESS;
+}
+
+uint32_t ReferenceParser::ParseRefInString(string &value, bool &update, const std::string &filePath) const
+{
+    if (ParseRefString(value, update, filePath)) {
+        return RESTOOL_SUCCESS;
+    }
+    return RESTOOL_ERROR;
+}
+
+uint32_t ReferenceParser::ParseRefInItem(ResourceItem &resourceItem, const string &output, RefResult &result)
+{
+    if (IsElementRef(resourceItem) && ParseRefInResourceItem(resourceItem) != RESTOOL_SUCCESS) {
+        return RESTOOL_ERROR;
+    }
+    if ((IsMediaRef(resourceItem) || IsProfileRef(resourceItem)) &&
+        ParseRefInJsonFile(resourceItem, output, false, result.layerIconIds) != RESTOOL_SUCCESS) {
+        return RESTOOL_ERROR;
+    }
+    return RESTOOL_SUCCESS;
+}
+
+uint32_t ReferenceParser::ParseRefInJsonFile(ResourceItem &resourceItem, const string &output,
+    const bool isIncrement, map<int64_t, set<int64_t>> &layerIconIds)
 {
     string jsonPath;
     ResType resType = resourceItem.GetResType();
@@ -127,19 +170,17 @@ uint32_t ReferenceParser::ParseRefInJsonFile(ResourceItem &resourceItem, const s
     if (resType == ResType::MEDIA) {
         jsonPath = FileEntry::FilePath(output).Append(RESOURCES_DIR).Append(resourceItem.GetLimitKey()).Append("media")
             .Append(resName).GetPath();
-        isParsingMediaJson_ = true;
-        mediaJsonId_ = idWorker_.GetId(resType, ResourceUtil::GetIdName(resName, resType));
-        if (mediaJsonId_ != INVALID_ID) {
-            set<int64_t> set;
-            layerIconIds_[mediaJsonId_] = set;
+        int64_t mediaJsonId = idWorker_.GetId(resType, ResourceUtil::GetIdName(resName, resType));
+        if (mediaJsonId != INVALID_ID) {
+            mediaLayerIcons_ = &layerIconIds[mediaJsonId];
+            mediaLayerIcons_->clear();
         }
     } else {
         jsonPath = FileEntry::FilePath(output).Append(RESOURCES_DIR).Append("base").Append("profile").Append(resName)
             .GetPath();
     }
     bool parseJsonRet = ParseRefJson(resourceItem.GetFilePath(), jsonPath);
-    isParsingMediaJson_ = false;
-    mediaJsonId_ = INVALID_ID;
+    mediaLayerIcons_ = nullptr;
     if (!parseJsonRet) {
         return RESTOOL_ERROR;
     }
@@ -150,25 +191,25 @@ uint32_t ReferenceParser::ParseRefInJsonFile(ResourceItem &resourceItem, const s
     return RESTOOL_SUCCESS;
 }
 
-uint32_t ReferenceParser::ParseRefInString(string &value, bool &update, const std::string &filePath) const
+bool ReferenceParser::ParseRefJson(const string &from, const string &to)
 {
-    if (ParseRefString(value, update, filePath)) {
-        return RESTOOL_SUCCESS;
+    cJSON *root = nullptr;
+    if (!ResourceUtil::OpenJsonFile(from, &root)) {
+        return false;
     }
-    return RESTOOL_ERROR;
+    bool ret = ParseRefJson(root, from, to);
+    cJSON_Delete(root);
+    return ret;
 }
 
-bool ReferenceParser::ParseRefJson(const string &from, const string &to)
+bool ReferenceParser::ParseRefJson(cJSON *root, const string &from, const string &to) const
 {
-    if (!ResourceUtil::OpenJsonFile(from, &root_)) {
-        return false;
-    }
-    if (!root_ || !cJSON_IsObject(root_)) {
+    if (!root || !cJSON_IsObject(root)) {
         PrintError(GetError(ERR_CODE_JSON_FORMAT_ERROR).SetPosition(from));
-        return RESTOOL_ERROR;
+        return false;
     }
     bool needSave = false;
-    if (!ParseRefJsonImpl(root_, needSave, from)) {
+    if (!ParseRefJsonImpl(root, needSave, from)) {
         return false;
     }
 
@@ -180,7 +221,7 @@ bool ReferenceParser::ParseRefJson(const string &from, const string &to)
         return false;
     }
 
-    if (!ResourceUtil::SaveToJsonFile(to, root_)) {
+    if (!ResourceUtil::SaveToJsonFile(to, root)) {
         return false;
     }
     return true;
@@ -279,50 +320,71 @@ bool ReferenceParser::ParseRefString(string &key) const
 
 bool ReferenceParser::ParseRefString(std::string &key, bool &update, const std::string &filePath) const
 {
+    // a reference is "$ohos:type:name" or "$type:name", type is [a-z]+ and name is not empty
     update = false;
-    if (regex_match(key, regex("^\\$ohos:[a-z]+:.+"))) {
+    string_view type;
+    size_t namePos = 0;
+    if (key.compare(0, OHOS_REF_PREFIX.length(), OHOS_REF_PREFIX) == 0 &&
+        SplitRef(key, OHOS_REF_PREFIX.length(), type, namePos)) {
         update = true;
-        return ParseRefImpl(key, ID_OHOS_REFS, true, filePath);
-    } else if (regex_match(key, regex("^\\$[a-z]+:.+"))) {
+        return ParseRefImpl(key, type, namePos, true, filePath);
+    } else if (!key.empty() && key[0] == '$' && SplitRef(key, 1, type, namePos)) {
         update = true;
-        return ParseRefImpl(key, ID_REFS, false, filePath);
+        return ParseRefImpl(key, type, namePos, false, filePath);
     }
     return true;
 }
 
-bool ReferenceParser::ParseRefImpl(string &key, const map<string, ResType> &refs, bool isSystem,
-    const std::string &filePath) const
+bool ReferenceParser::SplitRef(const string &key, size_t typePos, string_view &type, size_t &namePos) const
 {
-    for (const auto &ref : refs) {
-        smatch result;
-        if (regex_search(key, result, regex(ref.first))) {
-            string name = key.substr(result[0].str().length());
-            int64_t id = idWorker_.GetId(ref.second, name);
-            if (!isSystem && ref.second == ResType::MEDIA && mediaJsonId_ != 0
-                && layerIconIds_.find(mediaJsonId_) != layerIconIds_.end()) {
-                layerIconIds_[mediaJsonId_].insert(id);
-            }
-            if (isSystem) {
-                id = idWorker_.GetSystemId(ref.second, name);
-            }
-            if (id < 0) {
-                PrintError(GetError(ERR_CODE_REF_NOT_DEFINED).FormatCause(key.c_str()).SetPosition(filePath));
-                return false;
-            }
+    size_t pos = typePos;
+    while (pos < key.length() && key[pos] >= 'a' && key[pos] <= 'z') {
+        pos++;
+    }
+    if (pos == typePos || pos >= key.length() || key[pos] != ':') {
+        return false;
+    }
+    // the name must not be empty and, as '.' of a regex, not contain line terminators
+    namePos = pos + 1;
+    if (namePos >= key.length() || key.find_first_of("\r\n", namePos) != string::npos) {
+        return false;
+    }
+    type = string_view(key).substr(typePos, pos - typePos);
+    return true;
+}
 
-            key = to_string(id);
-            if (ref.second != ResType::ID) {
-                key = "$" + ResourceUtil::ResTypeToString(ref.second) + ":" + to_string(id);
-            }
-            return true;
+bool ReferenceParser::ParseRefImpl(string &key, string_view type, size_t namePos, bool isSystem,
+    const std::string &filePath) const
+{
+    auto ref = REF_TYPES.find(type);
+    if (ref == REF_TYPES.end()) {
+        string refer;
+        for (const auto &item : REF_TYPES) {
+            refer.append("^\\$").append(isSystem ? "ohos:" : "").append(item.first).append(": ");
         }
+        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_REF).FormatCause(key.c_str(), refer.c_str())
+            .SetPosition(filePath));
+        return false;
     }
-    string refer;
-    for (const auto &ref:refs) {
-        refer.append(ref.first).append(" ");
+
+    string name = key.substr(namePos);
+    int64_t id = idWorker_.GetId(ref->second, name);
+    if (!isSystem && ref->second == ResType::MEDIA && mediaLayerIcons_) {
+        mediaLayerIcons_->insert(id);
     }
-    PrintError(GetError(ERR_CODE_INVALID_RESOURCE_REF).FormatCause(key.c_str(), refer.c_str()).SetPosition(filePath));
-    return false;
+    if (isSystem) {
+        id = idWorker_.GetSystemId(ref->second, name);
+    }
+    if (id < 0) {
+        PrintError(GetError(ERR_CODE_REF_NOT_DEFINED).FormatCause(key.c_str()).SetPosition(filePath));
+        return false;
+    }
+
+    key = to_string(id);
+    if (ref->second != ResType::ID) {
+        key = "$" + ResourceUtil::ResTypeToString(ref->second) + ":" + to_string(id);
+    }
+    return true;
 }
 
 bool ReferenceParser::ParseRefJsonImpl(cJSON *node, bool &needSave, const std::string &filePath) const
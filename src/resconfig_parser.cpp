@@ -103,6 +103,12 @@ void ResConfigParser::InitFileListCommand(HandleBack callback)
         "ignoreResourcePathPattern", _1, Option::IGNORED_PATH));
     fileListHandles_.emplace("qualifiersConfig", bind(&ResConfigParser::GetQualifiersConfig, this,
         "qualifiersConfig", _1, Option::TARGET_CONFIG));
+    fileListHandles_.emplace("incremental", bind(&ResConfigParser::GetBool, this, "incremental", _1,
+        Option::INCREMENTAL, callback));
+    fileListHandles_.emplace("transcodeCache", bind(&ResConfigParser::GetString, this, "transcodeCache", _1,
+        Option::TRANSCODE_CACHE, callback));
+    fileListHandles_.emplace("trace", bind(&ResConfigParser::GetString, this, "trace", _1,
+        Option::TRACE, callback));
 }
 
 uint32_t ResConfigParser::GetString(const std::string &nodeName, const cJSON *node, int c, HandleBack callback)
@@ -22,6 +22,7 @@
 #include "header.h"
 #include "id_worker.h"
 #include "key_parser.h"
+#include "mapped_file.h"
 #include "reference_parser.h"
 #include "resource_table.h"
 #include "resource_util.h"
@@ -145,8 +146,7 @@ bool ResourceAppend::ScanResources(const string &resourcePath, const string &out
 
 bool ResourceAppend::ScanSubResources(const FileEntry entry, const string &resourcePath, const string &outputPath)
 {
-    vector<KeyParam> keyParams;
-    if (KeyParser::Parse(entry.GetFilePath().GetFilename(), keyParams)) {
+    if (KeyParser::Parse(entry.GetFilePath().GetFilename()) != nullptr) {
         for (const auto &child : entry.GetChilds()) {
             if (!ResourceUtil::IslegalPath(child->GetFilePath().GetFilename())) {
                 continue;
@@ -210,8 +210,8 @@ bool ResourceAppend::ScanIegalResources(const string &resourcePath, const string
 bool ResourceAppend::ScanLimitKey(const unique_ptr<FileEntry> &entry,
     const string &limitKey, const string outputPath)
 {
-    vector<KeyParam> keyParams;
-    if (!KeyParser::Parse(limitKey, keyParams)) {
+    auto keyParams = KeyParser::Parse(limitKey);
+    if (keyParams == nullptr) {
         PrintError(GetError(ERR_CODE_INVALID_LIMIT_KEY).FormatCause(limitKey.c_str())
             .SetPosition(entry->GetFilePath().GetPath().c_str()));
         return false;
@@ -326,8 +326,8 @@ bool ResourceAppend::ScanSingleFile(const string &filePath, const string &output
     }
 
     string limitKey = path.GetParent().GetParent().GetFilename();
-    vector<KeyParam> keyParams;
-    if (!KeyParser::Parse(limitKey, keyParams)) {
+    auto keyParams = KeyParser::Parse(limitKey);
+    if (keyParams == nullptr) {
         PrintError(GetError(ERR_CODE_INVALID_LIMIT_KEY).FormatCause(limitKey.c_str()).SetPosition(filePath));
         return false;
     }
@@ -402,26 +402,11 @@ bool ResourceAppend::WriteResourceItem(const ResourceItem &resourceItem, ostring
 
 bool ResourceAppend::LoadResourceItem(const string &filePath)
 {
-#ifdef __WIN32
-    return LoadResourceItemWin(filePath);
-#else
-    ifstream in(filePath, ifstream::in | ifstream::binary);
-    if (!in.is_open()) {
-        PrintError(GetError(ERR_CODE_OPEN_FILE_ERROR).FormatCause(filePath.c_str(), strerror(errno)));
-        return false;
-    }
-    
-    in.seekg(0, in.end);
-    int32_t length = in.tellg();
-    in.seekg(0, in.beg);
-    if (length <= 0) {
-        PrintError(GetError(ERR_CODE_READ_FILE_ERROR).FormatCause(filePath.c_str(), "file is empty"));
+    MappedFile file;
+    if (!file.Open(filePath)) {
         return false;
     }
-    char buffer[length];
-    in.read(buffer, length);
-    return LoadResourceItemFromMem(buffer, length);
-#endif
+    return LoadResourceItemFromMem(file.GetData(), file.GetSize());
 }
 
 bool ResourceAppend::ScanRawFilesOrResFiles(const string &path, const string &outputPath, const string &limit)
@@ -504,7 +489,7 @@ bool ResourceAppend::Push(const shared_ptr<ResourceItem> &resourceItem)
     }
 
     if (find_if(result->second.begin(), result->second.end(), [resourceItem](auto &iter) {
-              return resourceItem->GetLimitKey() == iter->GetLimitKey();
+              return resourceItem->GetLimitKeyId() == iter->GetLimitKeyId();
         }) != result->second.end()) {
         return true;
     }
@@ -539,16 +524,16 @@ void ResourceAppend::AddRef(const shared_ptr<ResourceItem> &resourceItem)
     }
 }
 
-bool ResourceAppend::LoadResourceItemFromMem(const char buffer[], int32_t length)
+bool ResourceAppend::LoadResourceItemFromMem(const char buffer[], size_t length)
 {
-    int32_t offset = 0;
+    size_t offset = 0;
     do {
         // name
-        string nameStr = ParseString(buffer, length, offset);
+        string_view nameStr = ParseString(buffer, length, offset);
         // limit key
-        string limitKeyStr = ParseString(buffer, length, offset);
+        string_view limitKeyStr = ParseString(buffer, length, offset);
         // file path
-        string filePathStr = ParseString(buffer, length, offset);
+        string_view filePathStr = ParseString(buffer, length, offset);
         // ResType
         int32_t type = ParseInt32(buffer, length, offset);
         ResType resType = static_cast<ResType>(type);
@@ -569,30 +554,31 @@ bool ResourceAppend::LoadResourceItemFromMem(const char buffer[], int32_t length
             return true;
         }
         // data
-        string data = ParseString(buffer, length, offset);
+        string_view data = ParseString(buffer, length, offset);
         if (resType ==  ResType::RAW || resType ==  ResType::RES) {
-            FileEntry::FilePath outPath(packageParser_.GetOutput());
-            if (ResourceUtil::FileExist(outPath.Append(data).GetPath())) {
+            FileEntry::FilePath outPath = FileEntry::FilePath(packageParser_.GetOutput()).Append(string(data));
+            if (ResourceUtil::FileExist(outPath.GetPath())) {
                 continue;
             }
-            if (!ResourceUtil::CreateDirs(outPath.Append(data).GetParent().GetPath())) {
+            if (!ResourceUtil::CreateDirs(outPath.GetParent().GetPath())) {
                 return false;
             }
 
-            if (!ResourceUtil::FileExist(filePathStr)) {
+            string filePath(filePathStr);
+            if (!ResourceUtil::FileExist(filePath)) {
                 continue;
             }
 
-            if (!ResourceUtil::CopyFileInner(filePathStr, outPath.Append(data).GetPath())) {
+            if (!ResourceUtil::CopyFileInner(filePath, outPath.GetPath())) {
                 return false;
             }
             continue;
         }
 
-        shared_ptr<ResourceItem> resourceItem = make_shared<ResourceItem>(nameStr, keyParams, resType);
-        resourceItem->SetData(reinterpret_cast<const int8_t *>(data.c_str()), data.length());
-        resourceItem->SetLimitKey(limitKeyStr);
-        resourceItem->SetFilePath(filePathStr);
+        shared_ptr<ResourceItem> resourceItem =
+            make_shared<ResourceItem>(string(nameStr), string(limitKeyStr), keyParams, resType);
+        resourceItem->SetData(reinterpret_cast<const int8_t *>(data.data()), data.length());
+        resourceItem->SetFilePath(string(filePathStr));
         if (!Push(resourceItem)) {
             return false;
         }
@@ -600,26 +586,23 @@ bool ResourceAppend::LoadResourceItemFromMem(const char buffer[], int32_t length
     return true;
 }
 
-string ResourceAppend::ParseString(const char buffer[], int32_t length, int32_t &offset) const
+string_view ResourceAppend::ParseString(const char buffer[], size_t length, size_t &offset) const
 {
     int32_t size = ParseInt32(buffer, length, offset);
-    if (size < 0 || offset + size > length) {
+    if (size < 0 || static_cast<size_t>(size) > length - offset) {
+        // not a null view, an empty data is still set to the item
         offset = length;
-        return "";
+        return string_view(buffer + offset, 0);
     }
 
-    if (size == 0) {
-        return "";
-    }
-
-    string value(buffer + offset, size);
-    offset += size;
+    string_view value(buffer + offset, size);
+    offset += static_cast<size_t>(size);
     return value;
 }
 
-int32_t ResourceAppend::ParseInt32(const char buffer[], int32_t length, int32_t &offset) const
+int32_t ResourceAppend::ParseInt32(const char buffer[], size_t length, size_t &offset) const
 {
-    if (offset + static_cast<int32_t>(sizeof(int32_t)) > length) {
+    if (sizeof(int32_t) > length - offset) {
         offset = length;
         return -1;
     }
@@ -642,7 +625,7 @@ bool ResourceAppend::CheckModuleResourceItem(const shared_ptr<ResourceItem> &res
     }
 
     const auto &ret = find_if(result->second.begin(), result->second.end(), [resourceItem](auto iter) {
-             return  resourceItem->GetLimitKey() == iter->GetLimitKey();
+             return  resourceItem->GetLimitKeyId() == iter->GetLimitKeyId();
     });
 
     if (ret != result->second.end()) {
@@ -656,45 +639,6 @@ bool ResourceAppend::CheckModuleResourceItem(const shared_ptr<ResourceItem> &res
     return true;
 }
 
-#ifdef __WIN32
-bool ResourceAppend::LoadResourceItemWin(const string &filePath)
-{
-    bool result = false;
-    HANDLE hReadFile = CreateFile(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
-        FILE_ATTRIBUTE_READONLY | FILE_FLAG_RANDOM_ACCESS, nullptr);
-    if (hReadFile == INVALID_HANDLE_VALUE) {
-        PrintError(GetError(ERR_CODE_CREATE_FILE_ERROR)
-            .FormatCause(filePath.c_str(), to_string(GetLastError()).c_str()).SetPosition(filePath));
-        return result;
-    }
-
-    DWORD fileSize = GetFileSize(hReadFile, nullptr);
-    HANDLE hFileMap = CreateFileMapping(hReadFile, nullptr, PAGE_READONLY, 0, fileSize, nullptr);
-    if (hFileMap == INVALID_HANDLE_VALUE) {
-        string errMsg = "create mapping error: " + to_string(GetLastError());
-        PrintError(GetError(ERR_CODE_READ_FILE_ERROR).FormatCause(filePath.c_str(), errMsg.c_str()));
-        CloseHandle(hReadFile);
-        return result;
-    }
-
-    void* pBuffer = MapViewOfFile(hFileMap, FILE_MAP_READ, 0, 0, 0);
-    if (pBuffer == nullptr) {
-        string errMsg = "map view of file error: " + to_string(GetLastError());
-        PrintError(GetError(ERR_CODE_READ_FILE_ERROR).FormatCause(filePath.c_str(), errMsg.c_str()));
-        CloseHandle(hFileMap);
-        CloseHandle(hReadFile);
-        return result;
-    }
-
-    char* buffer = reinterpret_cast<char *>(pBuffer);
-    result = LoadResourceItemFromMem(buffer, fileSize);
-    UnmapViewOfFile(pBuffer);
-    CloseHandle(hFileMap);
-    CloseHandle(hReadFile);
-    return result;
-}
-#endif
-
 bool ResourceAppend::IsBaseIdDefined(const FileInfo &fileInfo)
 {
     FileEntry::FilePath filePath(fileInfo.filePath);
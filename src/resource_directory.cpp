@@ -15,12 +15,15 @@
 
 #include "resource_directory.h"
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 
 #include "file_entry.h"
 #include "resource_util.h"
 #include "restool_errors.h"
 #include "select_compile_parse.h"
+#include "thread_pool.h"
 
 namespace OHOS {
 namespace Global {
@@ -33,6 +36,7 @@ bool ResourceDirectory::ScanResources(const string &resourcesDir, function<bool(
         return false;
     }
 
+    vector<pair<string, string>> limitKeyDirs;
     for (const auto &it : f.GetChilds()) {
         string limitKey = it->GetFilePath().GetFilename();
         if (ResourceUtil::IsIgnoreFile(*it)) {
@@ -48,24 +52,54 @@ bool ResourceDirectory::ScanResources(const string &resourcesDir, function<bool(
         if (limitKey == RAW_FILE_DIR || limitKey == RES_FILE_DIR) {
             continue;
         }
+        limitKeyDirs.emplace_back(limitKey, it->GetFilePath().GetPath());
+    }
+
+    // the directory order of the file system is not stable, the limit key directories are scanned in
+    // parallel and reported in name order, the directories after the first failed one are skipped
+    sort(limitKeyDirs.begin(), limitKeyDirs.end());
+    vector<ScanResult> results(limitKeyDirs.size());
+    atomic<size_t> firstFailed(limitKeyDirs.size());
+    ThreadPool::GetInstance().ParallelFor(limitKeyDirs.size(), [this, &limitKeyDirs, &results, &firstFailed](size_t i) {
+        if (i > firstFailed) {
+            return RESTOOL_SUCCESS;
+        }
+        string *lastBuffer = SetErrorBuffer(&results[i].errors);
+        results[i].success = ScanResourceLimitKeyDir(limitKeyDirs[i].second, limitKeyDirs[i].first,
+            results[i].directoryInfos);
+        SetErrorBuffer(lastBuffer);
+        if (!results[i].success) {
+            size_t failed = firstFailed;
+            while (i < failed && !firstFailed.compare_exchange_weak(failed, i)) {}
+            return RESTOOL_ERROR;
+        }
+        return RESTOOL_SUCCESS;
+    });
 
-        if (!ScanResourceLimitKeyDir(it->GetFilePath().GetPath(), limitKey, callback)) {
+    for (const auto &result : results) {
+        if (!result.success) {
+            PrintErrors(result.errors);
             return false;
         }
+        for (const auto &directoryInfo : result.directoryInfos) {
+            if (callback && !callback(directoryInfo)) {
+                return false;
+            }
+        }
     }
     return true;
 }
 
 // below private
 bool ResourceDirectory::ScanResourceLimitKeyDir(const string &resourceTypeDir, const string &limitKey,
-    function<bool(const DirectoryInfo&)> callback) const
+    vector<DirectoryInfo> &directoryInfos) const
 {
-    vector<KeyParam> keyParams;
-    if (!KeyParser::Parse(limitKey, keyParams)) {
+    auto keyParams = KeyParser::Parse(limitKey);
+    if (keyParams == nullptr) {
         PrintError(GetError(ERR_CODE_INVALID_LIMIT_KEY).FormatCause(limitKey.c_str()).SetPosition(resourceTypeDir));
         return false;
     }
-    if (!SelectCompileParse::IsSelectCompile(keyParams)) {
+    if (!SelectCompileParse::IsSelectCompile(*keyParams)) {
         return true;
     }
     FileEntry f(resourceTypeDir);
@@ -91,10 +125,7 @@ bool ResourceDirectory::ScanResourceLimitKeyDir(const string &resourceTypeDir, c
                            .SetPosition(dirPath));
             return false;
         }
-        DirectoryInfo info = { limitKey, fileCluster, dirPath, keyParams, type };
-        if (callback && !callback(info)) {
-            return false;
-        }
+        directoryInfos.push_back({ limitKey, fileCluster, dirPath, keyParams, type });
     }
     return true;
 }
@@ -24,7 +24,7 @@
 #include <functional>
 #include "cJSON.h"
 #include "resource_item.h"
-#include "resource_table.h"
+#include "resource_index_view.h"
 #include "resource_util.h"
 #include "restool_errors.h"
 
@@ -74,12 +74,11 @@ uint32_t ResourceDumper::LoadHap()
         return RESTOOL_ERROR;
     }
     unzClose(zipFile);
-    std::stringstream stream;
-    stream.write(buffer.get(), len);
-    if (ResourceTable::LoadResTable(stream, resInfos_) != RESTOOL_SUCCESS) {
+    ResourceIndexView indexView;
+    if (indexView.Open(buffer.get(), len) != RESTOOL_SUCCESS) {
         return RESTOOL_ERROR;
     }
-    return RESTOOL_SUCCESS;
+    return indexView.LoadAll(resInfos_);
 }
 
 void ResourceDumper::ReadHapInfo(const std::unique_ptr<char[]> &buffer, size_t len)
@@ -0,0 +1,465 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "resource_index_view.h"
+#include <algorithm>
+#include "resource_util.h"
+#include "restool_errors.h"
+#include "securec.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+using namespace std;
+namespace {
+constexpr uint32_t V1_HEADER_LEN = VERSION_MAX_LEN + sizeof(uint32_t) + sizeof(uint32_t);
+constexpr uint32_t V1_KEYS_HEADER_LEN = TAG_LEN + sizeof(uint32_t) + sizeof(uint32_t);
+constexpr uint32_t V1_IDSS_HEADER_LEN = TAG_LEN + sizeof(uint32_t);
+constexpr uint32_t V1_ID_DATA_LEN = sizeof(uint32_t) + sizeof(uint32_t);
+constexpr uint32_t V1_RECORD_HEADER_LEN = sizeof(uint32_t) + sizeof(int32_t) + sizeof(uint32_t);
+constexpr uint32_t V2_INDEX_HEADER_LEN = VERSION_MAX_LEN + 12;
+constexpr uint32_t V2_KEY_CONFIG_HEADER_LEN = 12;
+constexpr uint32_t V2_ID_SET_HEADER_LEN = 16;
+constexpr uint32_t V2_RES_TYPE_HEADER_LEN = 12;
+constexpr uint32_t V2_RES_INDEX_LEN = 12;
+constexpr uint32_t V2_RES_INFO_LEN = 12;
+constexpr uint32_t V2_DATA_OFFSET_LEN = 8;
+const vector<KeyParam> EMPTY_KEY_PARAMS;
+}
+
+uint32_t ResourceIndexView::Open(const string &path)
+{
+    Reset();
+    if (!file_.Open(path)) {
+        return RESTOOL_ERROR;
+    }
+    return Index(file_.GetData(), file_.GetSize());
+}
+
+uint32_t ResourceIndexView::Open(const char *data, size_t length)
+{
+    Reset();
+    file_.Close();
+    return Index(data, length);
+}
+
+bool ResourceIndexView::IsNewModule() const
+{
+    return newModule_;
+}
+
+const vector<ResourceIndexView::Entry> &ResourceIndexView::GetEntries() const
+{
+    return entries_;
+}
+
+const ResourceIndexView::Entry *ResourceIndexView::FindById(uint32_t id) const
+{
+    auto it = lower_bound(entries_.begin(), entries_.end(), id,
+        [](const Entry &entry, uint32_t target) { return entry.id < target; });
+    if (it == entries_.end() || it->id != id) {
+        return nullptr;
+    }
+    return &(*it);
+}
+
+const ResourceIndexView::Entry *ResourceIndexView::FindByName(ResType type, string_view name) const
+{
+    auto it = nameIndex_.find(make_pair(type, name));
+    if (it == nameIndex_.end()) {
+        return nullptr;
+    }
+    return &entries_[it->second];
+}
+
+bool ResourceIndexView::GetValues(const Entry &entry, vector<Value> &values) const
+{
+    values.clear();
+    if (newModule_) {
+        return GetValuesV2(entry, values);
+    }
+    return GetValuesV1(entry, values);
+}
+
+uint32_t ResourceIndexView::GetResourceItems(uint32_t id, vector<ResourceItem> &items) const
+{
+    items.clear();
+    for (const Entry *entry = FindById(id); entry != nullptr && entry != entries_.data() + entries_.size() &&
+        entry->id == id; entry++) {
+        if (!AppendItems(*entry, items)) {
+            return RESTOOL_ERROR;
+        }
+    }
+    return RESTOOL_SUCCESS;
+}
+
+uint32_t ResourceIndexView::LoadAll(map<int64_t, vector<ResourceItem>> &resInfos) const
+{
+    for (const auto &entry : entries_) {
+        if (!AppendItems(entry, resInfos[entry.id])) {
+            return RESTOOL_ERROR;
+        }
+    }
+    return RESTOOL_SUCCESS;
+}
+
+// below private
+template<typename T>
+bool ResourceIndexView::Read(uint64_t pos, T &value) const
+{
+    if (pos + sizeof(T) > length_) {
+        return false;
+    }
+    return memcpy_s(&value, sizeof(T), data_ + pos, sizeof(T)) == EOK;
+}
+
+uint32_t ResourceIndexView::Index(const char *data, size_t length)
+{
+    data_ = data;
+    length_ = length;
+    if (data_ == nullptr || length_ < V1_HEADER_LEN) {
+        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("header length error"));
+        return RESTOOL_ERROR;
+    }
+    string_view version(data_, VERSION_MAX_LEN);
+    newModule_ = version.substr(0, version.find(" ")) != RESTOOL_NAME;
+    bool result = newModule_ ? IndexV2() : IndexV1();
+    if (!result) {
+        Reset();
+        return RESTOOL_ERROR;
+    }
+    BuildNameIndex();
+    return RESTOOL_SUCCESS;
+}
+
+bool ResourceIndexView::IndexV1()
+{
+    uint32_t count = 0;
+    Read(VERSION_MAX_LEN + sizeof(uint32_t), count);
+    uint64_t pos = V1_HEADER_LEN;
+    map<uint64_t, uint32_t> keyOffsets; // <IDSS offset, index of keyConfigs_>
+    for (uint32_t i = 0; i < count; i++) {
+        if (pos + V1_KEYS_HEADER_LEN > length_) {
+            PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("KEYS length error"));
+            return false;
+        }
+        string keyTag(data_ + pos, TAG_LEN);
+        if (keyTag != "KEYS") {
+            PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX)
+                .FormatCause(string("invalid key tag = " + keyTag).c_str()));
+            return false;
+        }
+        uint32_t offset = 0;
+        uint32_t keyCount = 0;
+        Read(pos + TAG_LEN, offset);
+        Read(pos + TAG_LEN + sizeof(uint32_t), keyCount);
+        pos += V1_KEYS_HEADER_LEN;
+        if (pos + static_cast<uint64_t>(keyCount) * KeyParam::KEY_PARAM_LEN > length_) {
+            PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("keyParams length error"));
+            return false;
+        }
+        vector<KeyParam> keyParams(keyCount);
+        for (auto &keyParam : keyParams) {
+            Read(pos, keyParam.keyType);
+            Read(pos + sizeof(uint32_t), keyParam.value);
+            pos += KeyParam::KEY_PARAM_LEN;
+        }
+        keyOffsets[offset] = keyConfigs_.size();
+        keyConfigs_.push_back(move(keyParams));
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        if (pos + V1_IDSS_HEADER_LEN > length_) {
+            PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("IDSS length error"));
+            return false;
+        }
+        string idTag(data_ + pos, TAG_LEN);
+        if (idTag != "IDSS") {
+            PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX)
+                .FormatCause(string("invalid id tag = " + idTag).c_str()));
+            return false;
+        }
+        auto keyOffset = keyOffsets.find(pos);
+        if (keyOffset == keyOffsets.end()) {
+            PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("invalid limit key offset"));
+            return false;
+        }
+        uint32_t idCount = 0;
+        Read(pos + TAG_LEN, idCount);
+        pos += V1_IDSS_HEADER_LEN;
+        if (pos + static_cast<uint64_t>(idCount) * V1_ID_DATA_LEN > length_) {
+            PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("id data length error"));
+            return false;
+        }
+        for (uint32_t j = 0; j < idCount; j++) {
+            ValueRef ref = { 0, keyOffset->second, 0 };
+            Read(pos, ref.id);
+            Read(pos + sizeof(uint32_t), ref.dataOffset);
+            values_.push_back(ref);
+            pos += V1_ID_DATA_LEN;
+        }
+    }
+
+    // records of one id are kept in the order of their limit key configs
+    stable_sort(values_.begin(), values_.end(), [](const ValueRef &a, const ValueRef &b) { return a.id < b.id; });
+    for (size_t i = 0; i < values_.size();) {
+        Entry entry;
+        entry.id = values_[i].id;
+        entry.offset = i;
+        if (!ReadV1Record(values_[i], entry.type, entry.name)) {
+            return false;
+        }
+        while (i < values_.size() && values_[i].id == entry.id) {
+            entry.count++;
+            i++;
+        }
+        entries_.push_back(entry);
+    }
+    return true;
+}
+
+bool ResourceIndexView::IndexV2()
+{
+    uint64_t pos = V2_INDEX_HEADER_LEN;
+    if (pos > length_) {
+        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("header length error"));
+        return false;
+    }
+    uint32_t keyCount = 0;
+    Read(VERSION_MAX_LEN + sizeof(uint32_t), keyCount);
+    for (uint32_t key = 0; key < keyCount; key++) {
+        if (pos + V2_KEY_CONFIG_HEADER_LEN > length_) {
+            PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("KeyConfig header length error"));
+            return false;
+        }
+        uint32_t configId = 0;
+        uint32_t paramCount = 0;
+        Read(pos + TAG_LEN, configId);
+        Read(pos + TAG_LEN + sizeof(uint32_t), paramCount);
+        pos += V2_KEY_CONFIG_HEADER_LEN;
+        if (pos + static_cast<uint64_t>(paramCount) * KeyParam::KEY_PARAM_LEN > length_) {
+            PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("KeyParam length error"));
+            return false;
+        }
+        vector<KeyParam> keyParams(paramCount);
+        for (auto &keyParam : keyParams) {
+            Read(pos, keyParam.keyType);
+            Read(pos + sizeof(uint32_t), keyParam.value);
+            pos += KeyParam::KEY_PARAM_LEN;
+        }
+        configIndex_[configId] = keyConfigs_.size();
+        keyConfigs_.push_back(move(keyParams));
+    }
+
+    if (pos + V2_ID_SET_HEADER_LEN > length_) {
+        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("IdSet header length error"));
+        return false;
+    }
+    uint32_t typeCount = 0;
+    uint32_t idCount = 0;
+    Read(pos + TAG_LEN + sizeof(uint32_t), typeCount);
+    Read(pos + TAG_LEN + sizeof(uint32_t) + sizeof(uint32_t), idCount);
+    pos += V2_ID_SET_HEADER_LEN;
+    // the count is read from the file, a corrupt one must not reserve more than the file can hold
+    if (static_cast<uint64_t>(idCount) * V2_RES_INDEX_LEN > length_ - pos) {
+        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("IdSet id count error"));
+        return false;
+    }
+    entries_.reserve(idCount);
+    for (uint32_t resType = 0; resType < typeCount; resType++) {
+        if (pos + V2_RES_TYPE_HEADER_LEN > length_) {
+            PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("ResType header length error"));
+            return false;
+        }
+        uint32_t type = 0;
+        uint32_t count = 0;
+        Read(pos, type);
+        Read(pos + sizeof(uint32_t) + sizeof(uint32_t), count);
+        pos += V2_RES_TYPE_HEADER_LEN;
+        for (uint32_t resId = 0; resId < count; resId++) {
+            if (pos + V2_RES_INDEX_LEN > length_) {
+                PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("ResIndex length error"));
+                return false;
+            }
+            Entry entry;
+            uint32_t nameLen = 0;
+            entry.type = static_cast<ResType>(type);
+            Read(pos, entry.id);
+            Read(pos + sizeof(uint32_t), entry.offset);
+            Read(pos + sizeof(uint32_t) + sizeof(uint32_t), nameLen);
+            pos += V2_RES_INDEX_LEN;
+            if (pos + nameLen > length_) {
+                PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("resource name length error"));
+                return false;
+            }
+            entry.name = string_view(data_ + pos, nameLen);
+            pos += nameLen;
+            entries_.push_back(entry);
+        }
+    }
+    stable_sort(entries_.begin(), entries_.end(), [](const Entry &a, const Entry &b) { return a.id < b.id; });
+    return true;
+}
+
+bool ResourceIndexView::ReadV1Record(const ValueRef &ref, ResType &type, string_view &name) const
+{
+    uint64_t pos = ref.dataOffset;
+    uint32_t size = 0;
+    if (!Read(pos, size)) {
+        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("data record length error"));
+        return false;
+    }
+    if (pos + sizeof(uint32_t) + size > length_ || size < V1_RECORD_HEADER_LEN - sizeof(uint32_t)) {
+        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("record.size length error"));
+        return false;
+    }
+    int32_t resType = 0;
+    uint32_t id = 0;
+    Read(pos + sizeof(uint32_t), resType);
+    Read(pos + sizeof(uint32_t) + sizeof(int32_t), id);
+    if (id != ref.id) {
+        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("invalid id"));
+        return false;
+    }
+    auto resTypeIt = g_resTypeMap.find(resType);
+    if (resTypeIt == g_resTypeMap.end()) {
+        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("invalid resource type"));
+        return false;
+    }
+    type = resTypeIt->second;
+
+    pos += V1_RECORD_HEADER_LEN;
+    // the size also counts the resType and the id before the values
+    uint32_t valuesSize = size - (V1_RECORD_HEADER_LEN - sizeof(uint32_t));
+    uint16_t valueSize = 0;
+    Read(pos, valueSize);
+    if (valueSize + sizeof(uint16_t) > valuesSize) {
+        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("value size error"));
+        return false;
+    }
+    pos += sizeof(uint16_t) + valueSize;
+    uint16_t nameSize = 0;
+    Read(pos, nameSize);
+    if (valueSize + sizeof(uint16_t) + nameSize + sizeof(uint16_t) > valuesSize) {
+        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("name size error"));
+        return false;
+    }
+    const char *namePtr = data_ + pos + sizeof(uint16_t);
+    name = string_view(namePtr, strnlen(namePtr, nameSize));
+    return true;
+}
+
+bool ResourceIndexView::GetValuesV1(const Entry &entry, vector<Value> &values) const
+{
+    values.reserve(entry.count);
+    for (uint32_t i = entry.offset; i < entry.offset + entry.count && i < values_.size(); i++) {
+        const ValueRef &ref = values_[i];
+        ResType type;
+        string_view name;
+        if (!ReadV1Record(ref, type, name)) {
+            return false;
+        }
+        uint64_t pos = static_cast<uint64_t>(ref.dataOffset) + V1_RECORD_HEADER_LEN;
+        uint16_t valueSize = 0;
+        Read(pos, valueSize);
+        Value value;
+        value.keyParams = &keyConfigs_[ref.keyIndex];
+        value.data = reinterpret_cast<const int8_t *>(data_ + pos + sizeof(uint16_t));
+        value.length = valueSize;
+        values.push_back(value);
+    }
+    return true;
+}
+
+bool ResourceIndexView::GetValuesV2(const Entry &entry, vector<Value> &values) const
+{
+    uint64_t pos = entry.offset;
+    uint32_t valueCount = 0;
+    if (pos + V2_RES_INFO_LEN > length_) {
+        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("ResInfo length error"));
+        return false;
+    }
+    Read(pos + sizeof(uint32_t) + sizeof(uint32_t), valueCount);
+    pos += V2_RES_INFO_LEN;
+    if (pos + static_cast<uint64_t>(valueCount) * V2_DATA_OFFSET_LEN > length_) {
+        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("Config id length error"));
+        return false;
+    }
+    values.reserve(valueCount);
+    for (uint32_t i = 0; i < valueCount; i++) {
+        uint32_t configId = 0;
+        uint32_t dataOffset = 0;
+        Read(pos, configId);
+        Read(pos + sizeof(uint32_t), dataOffset);
+        pos += V2_DATA_OFFSET_LEN;
+
+        uint16_t dataLen = 0;
+        if (!Read(dataOffset, dataLen) ||
+            static_cast<uint64_t>(dataOffset) + sizeof(uint16_t) + dataLen > length_) {
+            PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("resource length error"));
+            return false;
+        }
+        Value value;
+        auto config = configIndex_.find(configId);
+        value.keyParams = config == configIndex_.end() ? &EMPTY_KEY_PARAMS : &keyConfigs_[config->second];
+        value.data = reinterpret_cast<const int8_t *>(data_ + dataOffset + sizeof(uint16_t));
+        value.length = dataLen;
+        values.push_back(value);
+    }
+    return true;
+}
+
+bool ResourceIndexView::AppendItems(const Entry &entry, vector<ResourceItem> &items) const
+{
+    vector<Value> values;
+    if (!GetValues(entry, values)) {
+        return false;
+    }
+    string name(entry.name);
+    for (const auto &value : values) {
+        ResourceItem resourceItem(name, ResourceUtil::PaserKeyParam(*value.keyParams), *value.keyParams, entry.type);
+        if (newModule_) {
+            // V2 values are loaded with one extra terminating '\0', same as the stream loader
+            resourceItem.SetData(string(reinterpret_cast<const char *>(value.data), value.length));
+        } else {
+            resourceItem.SetData(value.data, value.length);
+        }
+        resourceItem.MarkCoverable();
+        items.push_back(move(resourceItem));
+    }
+    return true;
+}
+
+void ResourceIndexView::BuildNameIndex()
+{
+    for (size_t i = 0; i < entries_.size(); i++) {
+        nameIndex_.emplace(make_pair(entries_[i].type, entries_[i].name), i);
+    }
+}
+
+void ResourceIndexView::Reset()
+{
+    data_ = nullptr;
+    length_ = 0;
+    newModule_ = false;
+    entries_.clear();
+    nameIndex_.clear();
+    keyConfigs_.clear();
+    configIndex_.clear();
+    values_.clear();
+}
+}
+}
+}
@@ -15,6 +15,7 @@
 
 #include "resource_item.h"
 #include <iostream>
+#include <new>
 #include "securec.h"
 
 namespace OHOS {
@@ -30,8 +31,28 @@ ResourceItem::ResourceItem(const ResourceItem &other)
     CopyFrom(other);
 }
 
+ResourceItem::ResourceItem(ResourceItem &&other) noexcept
+{
+    MoveFrom(other);
+}
+
 ResourceItem::ResourceItem(const string &name, const vector<KeyParam> &keyparams, ResType type)
-    : data_(nullptr), dataLen_(0), name_(name), keyparams_(keyparams), type_(type)
+    : data_(nullptr), dataLen_(0), name_(name), type_(type),
+    config_(ConfigTable::GetInstance().Intern("", keyparams))
+{
+}
+
+ResourceItem::ResourceItem(const string &name, const string &limitKey, const vector<KeyParam> &keyparams,
+    ResType type)
+    : data_(nullptr), dataLen_(0), name_(name), type_(type),
+    config_(ConfigTable::GetInstance().Intern(limitKey, keyparams))
+{
+}
+
+ResourceItem::ResourceItem(const string &name, const string &limitKey,
+    const shared_ptr<const vector<KeyParam>> &keyparams, ResType type)
+    : data_(nullptr), dataLen_(0), name_(name), type_(type),
+    config_(ConfigTable::GetInstance().Intern(limitKey, keyparams))
 {
 }
 
@@ -51,23 +72,24 @@ bool ResourceItem::SetData(const int8_t *data, uint32_t length)
         return false;
     }
 
-    ReleaseData();
-    if (length == 0) {
-        // the string in the element directory can be empty
-        data_ = reinterpret_cast<int8_t *>(new (nothrow) int8_t[0]);
-        dataLen_ = 0;
-        return data_ != nullptr;
-    }
-    int8_t *buffer = reinterpret_cast<int8_t *>(new (nothrow) int8_t[length]);
+    // the data may be the current data of this item, it is released after the copy
+    // the string in the element directory can be empty, the data is not null then
+    int8_t *buffer = new (nothrow) int8_t[sizeof(DataHeader) + length];
     if (buffer == nullptr) {
+        ReleaseData();
         return false;
     }
-
-    bool result = (memset_s(buffer, length, 0, length) == EOK);
-    result = result && (memcpy_s(buffer, length, data, length) == EOK);
+    new (buffer) DataHeader { 1 };
+    buffer += sizeof(DataHeader);
+    if (length > 0 && memcpy_s(buffer, length, data, length) != EOK) {
+        delete[] (buffer - sizeof(DataHeader));
+        ReleaseData();
+        return false;
+    }
+    ReleaseData();
     data_ = buffer;
     dataLen_ = length;
-    return result;
+    return true;
 }
 
 void ResourceItem::SetFilePath(const string &filePath)
@@ -77,7 +99,7 @@ void ResourceItem::SetFilePath(const string &filePath)
 
 void ResourceItem::SetLimitKey(const string &limitKey)
 {
-    limitKey_ = limitKey;
+    config_ = ConfigTable::GetInstance().Intern(limitKey, config_->keyParams);
 }
 
 void ResourceItem::SetName(const string &name)
@@ -112,7 +134,7 @@ const ResType &ResourceItem::GetResType() const
 
 const vector<KeyParam> &ResourceItem::GetKeyParam() const
 {
-    return keyparams_;
+    return *config_->keyParams;
 }
 
 const string &ResourceItem::GetFilePath() const
@@ -122,7 +144,17 @@ const string &ResourceItem::GetFilePath() const
 
 const string &ResourceItem::GetLimitKey() const
 {
-    return limitKey_;
+    return config_->limitKey;
+}
+
+uint32_t ResourceItem::GetLimitKeyId() const
+{
+    return config_->limitKeyId;
+}
+
+uint32_t ResourceItem::GetConfigId() const
+{
+    return config_->id;
 }
 
 bool ResourceItem::IsCoverable() const
@@ -165,12 +197,8 @@ void ResourceItem::CheckData()
     if (GetDataLength() == 0) {
         return;
     }
-    int8_t data[GetDataLength()];
-    for (uint32_t i = 0; i < GetDataLength(); i++) {
-        data[i] = GetData()[i];
-    }
-    if (data[GetDataLength() - 1] == '\0') {
-        SetData(data, GetDataLength() - 1);
+    if (GetData()[GetDataLength() - 1] == '\0') {
+        SetData(GetData(), GetDataLength() - 1);
     }
 }
 
@@ -183,11 +211,29 @@ ResourceItem &ResourceItem::operator=(const ResourceItem &other)
     return *this;
 }
 
+ResourceItem &ResourceItem::operator=(ResourceItem &&other) noexcept
+{
+    if (this == &other) {
+        return *this;
+    }
+    MoveFrom(other);
+    return *this;
+}
+
 // below private founction
+ResourceItem::DataHeader *ResourceItem::GetDataHeader(const int8_t *data)
+{
+    return reinterpret_cast<DataHeader *>(const_cast<int8_t *>(data) - sizeof(DataHeader));
+}
+
 void ResourceItem::ReleaseData()
 {
     if (data_ != nullptr) {
-        delete[] data_;
+        DataHeader *header = GetDataHeader(data_);
+        if (header->refCount.fetch_sub(1, memory_order_acq_rel) == 1) {
+            header->~DataHeader();
+            delete[] reinterpret_cast<int8_t *>(header);
+        }
         data_ = nullptr;
         dataLen_ = 0;
     }
@@ -196,15 +242,30 @@ void ResourceItem::ReleaseData()
 void ResourceItem::CopyFrom(const ResourceItem &other)
 {
     name_ = other.name_;
-    keyparams_ = other.keyparams_;
     type_ = other.type_;
-    dataLen_ = other.dataLen_;
     filePath_ = other.filePath_;
-    limitKey_ = other.limitKey_;
+    config_ = other.config_;
     coverable_ = other.coverable_;
-    if (!SetData(other.data_, other.dataLen_)) {
-        ReleaseData();
+    if (other.data_ != nullptr) {
+        GetDataHeader(other.data_)->refCount.fetch_add(1, memory_order_relaxed);
     }
+    ReleaseData();
+    data_ = other.data_;
+    dataLen_ = other.dataLen_;
+}
+
+void ResourceItem::MoveFrom(ResourceItem &other)
+{
+    name_ = move(other.name_);
+    type_ = other.type_;
+    filePath_ = move(other.filePath_);
+    config_ = other.config_;
+    coverable_ = other.coverable_;
+    ReleaseData();
+    data_ = other.data_;
+    dataLen_ = other.dataLen_;
+    other.data_ = nullptr;
+    other.dataLen_ = 0;
 }
 }
 }
@@ -15,6 +15,7 @@
 
 #include "resource_merge.h"
 #include "file_entry.h"
+#include "tracer.h"
 
 namespace OHOS {
 namespace Global {
@@ -38,6 +39,7 @@ ResourceMerge::~ResourceMerge()
 
 uint32_t ResourceMerge::Init(const PackageParser &packageParser)
 {
+    TraceScope scope("ResourceMerge::Init");
     const vector<string> &inputs = packageParser.GetInputs();
     if (packageParser.IsFileList()) {
         inputsOrder_ = inputs;
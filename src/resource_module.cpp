@@ -21,6 +21,7 @@
 #include "config_parser.h"
 #include "resource_compiler_factory.h"
 #include "restool_errors.h"
+#include "tracer.h"
 
 namespace OHOS {
 namespace Global {
@@ -47,6 +48,15 @@ ResourceModule::ResourceModule(const string &modulePath, const string &moduleOut
 
 uint32_t ResourceModule::ScanResource(bool isHap)
 {
+    if (ScanDirectorys() != RESTOOL_SUCCESS) {
+        return RESTOOL_ERROR;
+    }
+    return CompileDirectorys(isHap);
+}
+
+uint32_t ResourceModule::ScanDirectorys()
+{
+    TraceScope scope("ScanDirectorys " + modulePath_);
     if (!ResourceUtil::FileExist(modulePath_)) {
         return RESTOOL_SUCCESS;
     }
@@ -58,13 +68,18 @@ uint32_t ResourceModule::ScanResource(bool isHap)
         })) {
         return RESTOOL_ERROR;
     }
+    return RESTOOL_SUCCESS;
+}
 
+uint32_t ResourceModule::CompileDirectorys(bool isHap)
+{
     for (const auto &type : SCAN_SEQ) {
         const auto &item = scanDirs_.find(type);
         if (item == scanDirs_.end() || item->second.empty()) {
             continue;
         }
 
+        TraceScope scope("Compile " + ResourceUtil::ResTypeToString(type) + " " + modulePath_);
         unique_ptr<IResourceCompiler> resourceCompiler =
             ResourceCompilerFactory::CreateCompiler(type, moduleOutput_, isHap, isHarResource_);
         resourceCompiler->SetModuleName(moduleName_);
@@ -97,7 +112,7 @@ uint32_t ResourceModule::MergeResourceItem(map<int64_t, vector<ResourceItem>> &a
 
         for (const auto &resourceItem : iter.second) {
             auto ret = find_if(result.first->second.begin(), result.first->second.end(), [&resourceItem](auto &iter) {
-                return resourceItem.GetLimitKey() == iter.GetLimitKey();
+                return resourceItem.GetLimitKeyId() == iter.GetLimitKeyId();
             });
             if (ret == result.first->second.end()) {
                 result.first->second.push_back(resourceItem);
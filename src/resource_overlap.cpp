@@ -80,6 +80,8 @@ uint32_t ResourceOverlap::ScanResources(const std::vector<std::string> &inputs,
 
 uint32_t ResourceOverlap::LoadHapResources()
 {
+    // every resource of the hap is written to the new index, so all of them are decoded, only the ones
+    // overridden by the overlap inputs could be skipped
     ResourceTable resourceTabel;
     map<int64_t, vector<ResourceItem>> items;
     string resourceIndexPath =
@@ -22,10 +22,15 @@
 #include "header.h"
 #include "resource_check.h"
 #include "resource_merge.h"
+#include "resource_index_view.h"
 #include "resource_table.h"
 #include "compression_parser.h"
 #include "binary_file_packer.h"
+#include "build_state.h"
+#include "output_sink.h"
 #include "resource_packer_factory.h"
+#include "tracer.h"
+#include "transcode_cache.h"
 
 namespace OHOS {
 namespace Global {
@@ -36,6 +41,10 @@ ResourcePack::ResourcePack(const PackageParser &packageParser):packageParser_(pa
 
 uint32_t ResourcePack::Package()
 {
+    if (!packageParser_.GetTracePath().empty()) {
+        Tracer::GetInstance().Start(packageParser_.GetTracePath());
+        Tracer::GetInstance().SetThreadName("main");
+    }
     uint32_t errorCode = RESTOOL_SUCCESS;
     if (!packageParser_.GetAppend().empty()) {
         errorCode = PackAppend();
@@ -53,8 +62,14 @@ uint32_t ResourcePack::Package()
         errorCode = resourcePacker->Pack();
     }
     if (errorCode == RESTOOL_SUCCESS) {
+        errorCode = OutputSink::GetInstance().Reconcile();
+    }
+    if (errorCode == RESTOOL_SUCCESS) {
+        TranscodeCache::GetInstance().Trim();
         ShowPackSuccess();
     }
+    // the trace of a failed build is saved too, it shows where the build stopped
+    Tracer::GetInstance().Save();
     return errorCode;
 }
 
@@ -63,6 +78,7 @@ uint32_t ResourcePack::InitCompression()
     if (!packageParser_.GetCompressionPath().empty()) {
         auto compressionMgr = CompressionParser::GetCompressionParser(packageParser_.GetCompressionPath());
         compressionMgr->SetOutPath(packageParser_.GetOutput());
+        compressionMgr->SetCachePath(packageParser_.GetTranscodeCachePath());
         if (compressionMgr->Init() != RESTOOL_SUCCESS) {
             return RESTOOL_ERROR;
         }
@@ -73,11 +89,13 @@ uint32_t ResourcePack::InitCompression()
 // below private founction
 uint32_t ResourcePack::InitResourcePack()
 {
+    TraceScope scope("InitResourcePack");
     InitHeaderCreater();
     if (InitCompression() != RESTOOL_SUCCESS) {
         return RESTOOL_ERROR;
     }
 
+    InitBuildState();
     if (InitOutput() != RESTOOL_SUCCESS) {
         return RESTOOL_ERROR;
     }
@@ -89,6 +107,9 @@ uint32_t ResourcePack::InitResourcePack()
     if (InitModule() != RESTOOL_SUCCESS) {
         return RESTOOL_ERROR;
     }
+    if (BuildState::GetInstance().HasLastState()) {
+        IdWorker::GetInstance().SetCacheIds(BuildState::GetInstance().GetIds());
+    }
     if (ThreadPool::GetInstance().Start(packageParser_.GetThreadCount()) != RESTOOL_SUCCESS) {
         return RESTOOL_ERROR;
     };
@@ -140,6 +161,41 @@ uint32_t ResourcePack::InitModule()
     return RESTOOL_SUCCESS;
 }
 
+void ResourcePack::InitBuildState() const
+{
+    if (!packageParser_.IsIncremental()) {
+        return;
+    }
+    if (packageParser_.IsOverlap()) {
+        cout << "Warning: incremental build is not supported in overlap mode, build all resources." << endl;
+        return;
+    }
+    string options = RESTOOL_VERSION;
+    options.append("|").append(packageParser_.GetPackageName());
+    options.append("|").append(to_string(packageParser_.GetStartId()));
+    for (const auto &moduleName : packageParser_.GetModuleNames()) {
+        options.append("|").append(moduleName);
+    }
+    vector<string> dependencies = packageParser_.GetSysIdDefinedPaths();
+    if (!packageParser_.GetIdDefinedInputPath().empty()) {
+        dependencies.push_back(packageParser_.GetIdDefinedInputPath());
+    }
+    if (!packageParser_.GetCompressionPath().empty()) {
+        dependencies.push_back(packageParser_.GetCompressionPath());
+    }
+    BuildState::GetInstance().Load(packageParser_.GetOutput(), options, dependencies);
+}
+
+uint32_t ResourcePack::SaveBuildState() const
+{
+    BuildState &buildState = BuildState::GetInstance();
+    if (!buildState.IsEnabled()) {
+        return RESTOOL_SUCCESS;
+    }
+    buildState.SetIds(IdWorker::GetInstance().GetIds());
+    return buildState.Save();
+}
+
 void ResourcePack::InitHeaderCreater()
 {
     using namespace placeholders;
@@ -155,11 +211,22 @@ uint32_t ResourcePack::InitOutput() const
     bool combine = packageParser_.GetCombine();
     string output = packageParser_.GetOutput();
     string resourcesPath = FileEntry::FilePath(output).Append(RESOURCES_DIR).GetPath();
+    // combine writes its outputs without the output sink, so they can not be recorded
+    bool hasManifest = OutputSink::GetInstance().LoadManifest(output, !combine);
     if (ResourceUtil::FileExist(resourcesPath)) {
+        if (BuildState::GetInstance().HasLastState()) {
+            // incremental build, the unchanged outputs of the last build are reused
+            return RESTOOL_SUCCESS;
+        }
         if (!forceWrite) {
             PrintError(GetError(ERR_CODE_OUTPUT_EXIST).SetPosition(resourcesPath));
             return RESTOOL_ERROR;
         }
+        if (hasManifest) {
+            // the manifest lists every file of the directory, the ones not written again are removed after the build
+            cout << "Info: reconcile the output directory '" << resourcesPath << "'." << endl;
+            return RESTOOL_SUCCESS;
+        }
 
         if (!ResourceUtil::RmoveAllDir(resourcesPath)) {
             return combine ? RESTOOL_SUCCESS : RESTOOL_ERROR;
@@ -170,6 +237,7 @@ uint32_t ResourcePack::InitOutput() const
 
 uint32_t ResourcePack::GenerateHeader() const
 {
+    TraceScope scope("GenerateHeader");
     auto headerPaths = packageParser_.GetResourceHeaders();
     string textPath = FileEntry::FilePath(packageParser_.GetOutput()).Append("ResourceTable.txt").GetPath();
     headerPaths.push_back(textPath);
@@ -327,6 +395,7 @@ uint32_t ResourcePack::GenerateTsHeader(const std::string &headerPath) const
 
 uint32_t ResourcePack::GenerateConfigJson()
 {
+    TraceScope scope("GenerateConfigJson");
     if (configJson_.ParseRefence() != RESTOOL_SUCCESS) {
         return RESTOOL_ERROR;
     }
@@ -375,7 +444,8 @@ uint32_t ResourcePack::Pack()
     if (rawFilePacker.GetResult() != RESTOOL_SUCCESS) {
         return RESTOOL_ERROR;
     }
-    return RESTOOL_SUCCESS;
+    OutputSink::GetInstance().PrintStatistics();
+    return SaveBuildState();
 }
 
 uint32_t ResourcePack::PackResources(const ResourceMerge &resourceMerge)
@@ -436,9 +506,8 @@ uint32_t ResourcePack::HandleFeature()
         return RESTOOL_ERROR;
     }
     string path = FileEntry::FilePath(featureDependEntry).Append(RESOURCE_INDEX_FILE).GetPath();
-    map<int64_t, vector<ResourceItem>> resInfoLocal;
-    ResourceTable resourceTable;
-    if (resourceTable.LoadResTable(path, resInfoLocal) != RESTOOL_SUCCESS) {
+    ResourceIndexView indexView;
+    if (indexView.Open(path) != RESTOOL_SUCCESS) {
         return RESTOOL_ERROR;
     }
     jsonFile = FileEntry::FilePath(output).Append(CONFIG_JSON).GetPath();
@@ -447,12 +516,12 @@ uint32_t ResourcePack::HandleFeature()
         return RESTOOL_ERROR;
     }
     vector<ResourceItem> items;
-    if (FindResourceItems(resInfoLocal, items, labelId) != RESTOOL_SUCCESS ||
+    if (FindResourceItems(indexView, items, labelId) != RESTOOL_SUCCESS ||
         HandleLabel(items, config) != RESTOOL_SUCCESS) {
         return RESTOOL_ERROR;
     }
     items.clear();
-    if (FindResourceItems(resInfoLocal, items, iconId) != RESTOOL_SUCCESS ||
+    if (FindResourceItems(indexView, items, iconId) != RESTOOL_SUCCESS ||
         HandleIcon(items, config) != RESTOOL_SUCCESS) {
         return RESTOOL_ERROR;
     }
@@ -464,17 +533,18 @@ uint32_t ResourcePack::HandleFeature()
     return RESTOOL_SUCCESS;
 }
 
-uint32_t ResourcePack::FindResourceItems(const map<int64_t, vector<ResourceItem>> &resInfoLocal,
+uint32_t ResourcePack::FindResourceItems(const ResourceIndexView &indexView,
                                          vector<ResourceItem> &items, int64_t id) const
 {
-    auto ret = resInfoLocal.find(id);
-    if (ret == resInfoLocal.end()) {
+    if (indexView.FindById(id) == nullptr) {
         string msg = "the id '" + std::to_string(id) + "' not found";
         PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause(msg.c_str()));
         return RESTOOL_ERROR;
     }
     ResType type = ResType::INVALID_RES_TYPE;
-    items = ret->second;
+    if (indexView.GetResourceItems(id, items) != RESTOOL_SUCCESS) {
+        return RESTOOL_ERROR;
+    }
     if (items.empty()) {
         string msg = "the items of id '" + std::to_string(id) + "' is empty";
         PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause(msg.c_str()));
@@ -573,8 +643,7 @@ uint32_t ResourcePack::HandleIcon(vector<ResourceItem> &items, ConfigParser &con
         }
         string data = FileEntry::FilePath(moduleName_).Append(dataPath).GetParent().Append(fileName).GetPath();
         ResourceUtil::StringReplace(data, WIN_SEPARATOR, SEPARATOR);
-        ResourceItem resourceItem(fileName, it.GetKeyParam(), ResType::MEDIA);
-        resourceItem.SetLimitKey(it.GetLimitKey());
+        ResourceItem resourceItem(fileName, it.GetLimitKey(), it.GetKeyParam(), ResType::MEDIA);
         if (!resourceItem.SetData(reinterpret_cast<const int8_t *>(data.c_str()), data.length())) {
             return RESTOOL_ERROR;
         }
@@ -21,8 +21,11 @@
 #include "cmd/cmd_parser.h"
 #include "file_entry.h"
 #include "file_manager.h"
+#include "output_sink.h"
+#include "resource_index_view.h"
 #include "resource_util.h"
 #include "securec.h"
+#include "tracer.h"
 
 namespace OHOS {
 namespace Global {
@@ -45,9 +48,10 @@ ResourceTable::~ResourceTable()
 
 uint32_t ResourceTable::CreateResourceTable()
 {
+    TraceScope scope("CreateResourceTable");
     FileManager &fileManager = FileManager::GetInstance();
     auto &allResource = fileManager.GetResources();
-    map<string, vector<TableData>> configs;
+    unordered_map<uint32_t, vector<TableData>> groups;
     for (const auto &item : allResource) {
         for (const auto &resourceItem : item.second) {
             if (resourceItem.GetResType() == ResType::ID) {
@@ -56,9 +60,11 @@ uint32_t ResourceTable::CreateResourceTable()
             TableData tableData;
             tableData.id = item.first;
             tableData.resourceItem = resourceItem;
-            configs[resourceItem.GetLimitKey()].push_back(tableData);
+            groups[resourceItem.GetLimitKeyId()].push_back(move(tableData));
         }
     }
+    map<string, vector<TableData>> configs;
+    GroupByLimitKey(groups, configs);
 
     if (!newResIndex_) {
         if (SaveToResouorceIndex(configs) != RESTOOL_SUCCESS) {
@@ -80,7 +86,7 @@ uint32_t ResourceTable::CreateResourceTable()
 
 uint32_t ResourceTable::CreateResourceTable(const map<int64_t, vector<shared_ptr<ResourceItem>>> &items)
 {
-    map<string, vector<TableData>> configs;
+    unordered_map<uint32_t, vector<TableData>> groups;
     map<int64_t, vector<ResourceItem>> allResource;
     for (const auto &item : items) {
         vector<ResourceItem> resourceItems;
@@ -92,10 +98,12 @@ uint32_t ResourceTable::CreateResourceTable(const map<int64_t, vector<shared_ptr
             tableData.id = item.first;
             tableData.resourceItem = *resourceItemPtr;
             resourceItems.push_back(*resourceItemPtr);
-            configs[resourceItemPtr->GetLimitKey()].push_back(tableData);
+            groups[resourceItemPtr->GetLimitKeyId()].push_back(move(tableData));
         }
-        allResource.emplace(item.first, resourceItems);
+        allResource.emplace(item.first, move(resourceItems));
     }
+    map<string, vector<TableData>> configs;
+    GroupByLimitKey(groups, configs);
 
     if (!newResIndex_) {
         if (SaveToResouorceIndex(configs) != RESTOOL_SUCCESS) {
@@ -117,63 +125,11 @@ uint32_t ResourceTable::CreateResourceTable(const map<int64_t, vector<shared_ptr
 
 uint32_t ResourceTable::LoadResTable(const string path, map<int64_t, vector<ResourceItem>> &resInfos)
 {
-    ifstream in(path, ios::binary);
-    if (!in.is_open()) {
-        PrintError(GetError(ERR_CODE_OPEN_FILE_ERROR).FormatCause(path.c_str(), strerror(errno)));
-        return RESTOOL_ERROR;
-    }
-
-    in.seekg(0, ios::end);
-    int64_t length = in.tellg();
-    if (length <= 0) {
-        in.close();
-        PrintError(GetError(ERR_CODE_READ_FILE_ERROR).FormatCause(path.c_str(), "file is empty"));
-        return RESTOOL_ERROR;
-    }
-    in.seekg(0, ios::beg);
-    uint32_t errorCode = LoadResTable(in, resInfos);
-    in.close();
-    return errorCode;
-}
-
-uint32_t ResourceTable::LoadResTable(basic_istream<char> &in, map<int64_t, vector<ResourceItem>> &resInfos)
-{
-    if (!in) {
-        std::string msg = "file stream bad, state code: " + std::to_string(in.rdstate());
-        PrintError(GetError(ERR_CODE_READ_FILE_ERROR).FormatCause(in.rdstate(), msg.c_str()));
-        return RESTOOL_ERROR;
-    }
-    in.seekg(0, ios::end);
-    int64_t length = in.tellg();
-    in.seekg(0, ios::beg);
-    uint64_t pos = 0;
-    IndexHeader indexHeader;
-    if (!ReadFileHeader(in, indexHeader, pos, static_cast<uint64_t>(length))) {
-        return RESTOOL_ERROR;
-    }
-
-    if (IsNewModule(indexHeader)) {
-        return LoadNewResTable(in, resInfos);
-    }
-
-    map<int64_t, vector<KeyParam>> limitKeys;
-    if (!ReadLimitKeys(in, limitKeys, indexHeader.limitKeyConfigSize, pos, static_cast<uint64_t>(length))) {
-        return RESTOOL_ERROR;
-    }
-
-    map<int64_t, pair<int64_t, int64_t>> datas;
-    if (!ReadIdTables(in, datas, indexHeader.limitKeyConfigSize, pos, static_cast<uint64_t>(length))) {
+    ResourceIndexView indexView;
+    if (indexView.Open(path) != RESTOOL_SUCCESS) {
         return RESTOOL_ERROR;
     }
-
-    while (in.tellg() < length) {
-        RecordItem record;
-        if (!ReadDataRecordPrepare(in, record, pos, static_cast<uint64_t>(length)) ||
-            !ReadDataRecordStart(in, record, limitKeys, datas, resInfos)) {
-            return RESTOOL_ERROR;
-        }
-    }
-    return RESTOOL_SUCCESS;
+    return indexView.LoadAll(resInfos);
 }
 
 uint32_t ResourceTable::CreateIdDefined(const map<int64_t, vector<ResourceItem>> &allResource) const
@@ -229,6 +185,15 @@ uint32_t ResourceTable::CreateIdDefined(const map<int64_t, vector<ResourceItem>>
 }
 
 // below private
+void ResourceTable::GroupByLimitKey(unordered_map<uint32_t, vector<TableData>> &groups,
+    map<string, vector<TableData>> &configs)
+{
+    // the items are grouped by the interned limit key id, the limit key string is only used once per group
+    for (auto &group : groups) {
+        configs.emplace(group.second.front().resourceItem.GetLimitKey(), move(group.second));
+    }
+}
+
 uint32_t ResourceTable::SaveToResouorceIndex(const map<string, vector<TableData>> &configs) const
 {
     uint32_t pos = 0;
@@ -244,12 +209,6 @@ uint32_t ResourceTable::SaveToResouorceIndex(const map<string, vector<TableData>
         return RESTOOL_ERROR;
     }
 
-    ofstream out(indexFilePath_, ofstream::out | ofstream::binary);
-    if (!out.is_open()) {
-        PrintError(GetError(ERR_CODE_OPEN_FILE_ERROR).FormatCause(indexFilePath_.c_str(), strerror(errno)));
-        return RESTOOL_ERROR;
-    }
-
     ostringstream outStreamData;
     if (!SaveRecordItem(configs, outStreamData, idSets, pos)) {
         return RESTOOL_ERROR;
@@ -260,8 +219,10 @@ uint32_t ResourceTable::SaveToResouorceIndex(const map<string, vector<TableData>
     SaveHeader(indexHeader, outStreamHeader);
     SaveLimitKeyConfigs(limitKeyConfigs, outStreamHeader);
     SaveIdSets(idSets, outStreamHeader);
-    out << outStreamHeader.str();
-    out << outStreamData.str();
+    outStreamHeader << outStreamData.str();
+    if (!OutputSink::GetInstance().Write(indexFilePath_, outStreamHeader.str())) {
+        return RESTOOL_ERROR;
+    }
     return RESTOOL_SUCCESS;
 }
 
@@ -340,95 +301,141 @@ void ResourceTable::PrepareResInfo(DataHeader &dataHeader, const uint32_t resId,
     dataHeader.length += ResInfo::DATA_OFFSET_LEN;
 }
 
-void ResourceTable::WriteDataPool(ostringstream &dataPool, const ResourceItem &resourceItem, uint32_t &dataPoolLen)
+ResourceTable::IndexWriter::IndexWriter(uint32_t size) : buffer_(new (nothrow) int8_t[size]()), size_(size)
+{
+}
+
+bool ResourceTable::IndexWriter::IsValid() const
+{
+    return buffer_ != nullptr;
+}
+
+void ResourceTable::IndexWriter::Seek(uint32_t pos)
+{
+    pos_ = pos;
+}
+
+void ResourceTable::IndexWriter::Write(const void *src, uint32_t len)
+{
+    if (len == 0) {
+        return;
+    }
+    if (overflow_ || pos_ > size_ || len > size_ - pos_ ||
+        memcpy_s(buffer_.get() + pos_, size_ - pos_, src, len) != EOK) {
+        overflow_ = true;
+        return;
+    }
+    pos_ += len;
+    end_ = max(end_, pos_);
+}
+
+bool ResourceTable::IndexWriter::IsOverflow() const
+{
+    return overflow_;
+}
+
+const int8_t *ResourceTable::IndexWriter::GetData() const
 {
-    uint32_t length = resourceItem.GetDataLength();
-    const int8_t *data = resourceItem.GetData();
-    dataPool.write(reinterpret_cast<const char *>(&length), sizeof(uint16_t));
-    dataPool.write(reinterpret_cast<const char *>(data), length);
-    dataPoolLen += sizeof(uint16_t) + length;
+    return buffer_.get();
 }
 
-void ResourceTable::WriteResInfo(ostringstream &dataBlock, const DataHeader &idSetHeader,
+uint32_t ResourceTable::IndexWriter::GetSize() const
+{
+    return end_;
+}
+
+uint32_t ResourceTable::IndexWriter::GetCapacity() const
+{
+    return size_;
+}
+
+void ResourceTable::WriteDataPool(IndexWriter &writer, const map<string, vector<TableData>> &configs)
+{
+    for (const auto &config : configs) {
+        for (const auto &tableData : config.second) {
+            uint32_t length = tableData.resourceItem.GetDataLength();
+            writer.Write(&length, sizeof(uint16_t));
+            writer.Write(tableData.resourceItem.GetData(), length);
+        }
+    }
+}
+
+void ResourceTable::WriteResInfo(IndexWriter &writer, const DataHeader &dataHeader,
     const uint32_t dataBlockOffset, unordered_map<uint32_t, uint32_t> &idOffsetMap)
 {
     uint32_t offset = dataBlockOffset;
-    dataBlock.write(reinterpret_cast<const char *>(idSetHeader.idTag), TAG_LEN);
-    dataBlock.write(reinterpret_cast<const char *>(&idSetHeader.length), sizeof(uint32_t));
-    dataBlock.write(reinterpret_cast<const char *>(&idSetHeader.idCount), sizeof(uint32_t));
+    writer.Seek(dataBlockOffset);
+    writer.Write(dataHeader.idTag, TAG_LEN);
+    writer.Write(&dataHeader.length, sizeof(uint32_t));
+    writer.Write(&dataHeader.idCount, sizeof(uint32_t));
     offset += DataHeader::DATA_HEADER_LEN;
-    for (const auto &resInfo : idSetHeader.resInfos) {
+    for (const auto &resInfo : dataHeader.resInfos) {
         idOffsetMap[resInfo.second.resId] = offset;
-        dataBlock.write(reinterpret_cast<const char *>(&resInfo.second.resId), sizeof(uint32_t));
-        dataBlock.write(reinterpret_cast<const char *>(&resInfo.second.length), sizeof(uint32_t));
-        dataBlock.write(reinterpret_cast<const char *>(&resInfo.second.valueCount), sizeof(uint32_t));
+        writer.Write(&resInfo.second.resId, sizeof(uint32_t));
+        writer.Write(&resInfo.second.length, sizeof(uint32_t));
+        writer.Write(&resInfo.second.valueCount, sizeof(uint32_t));
         offset += ResInfo::RES_INFO_LEN;
         for (const auto &dataOffset : resInfo.second.dataOffset) {
             uint32_t configId = dataOffset.first;
-            uint32_t realOffset = dataOffset.second + idSetHeader.length + dataBlockOffset;
-            dataBlock.write(reinterpret_cast<const char *>(&configId), sizeof(uint32_t));
-            dataBlock.write(reinterpret_cast<const char *>(&realOffset), sizeof(uint32_t));
+            uint32_t realOffset = dataOffset.second + dataHeader.length + dataBlockOffset;
+            writer.Write(&configId, sizeof(uint32_t));
+            writer.Write(&realOffset, sizeof(uint32_t));
             offset += ResInfo::DATA_OFFSET_LEN;
         }
     }
 }
 
-void ResourceTable::WriteIdSet(ostringstream &idSetBlock, const IdSetHeader &idSetHeader,
+void ResourceTable::WriteIdSet(IndexWriter &writer, const IdSetHeader &idSetHeader,
     const unordered_map<uint32_t, uint32_t> &idOffsetMap)
 {
-    idSetBlock.write(reinterpret_cast<const char *>(idSetHeader.idTag), TAG_LEN);
-    idSetBlock.write(reinterpret_cast<const char *>(&idSetHeader.length), sizeof(uint32_t));
-    idSetBlock.write(reinterpret_cast<const char *>(&idSetHeader.typeCount), sizeof(uint32_t));
-    idSetBlock.write(reinterpret_cast<const char *>(&idSetHeader.idCount), sizeof(uint32_t));
+    writer.Write(idSetHeader.idTag, TAG_LEN);
+    writer.Write(&idSetHeader.length, sizeof(uint32_t));
+    writer.Write(&idSetHeader.typeCount, sizeof(uint32_t));
+    writer.Write(&idSetHeader.idCount, sizeof(uint32_t));
     for (const auto &resType : idSetHeader.resTypes) {
-        idSetBlock.write(reinterpret_cast<const char *>(&resType.second.resType), sizeof(uint32_t));
-        idSetBlock.write(reinterpret_cast<const char *>(&resType.second.length), sizeof(uint32_t));
-        idSetBlock.write(reinterpret_cast<const char *>(&resType.second.count), sizeof(uint32_t));
+        writer.Write(&resType.second.resType, sizeof(uint32_t));
+        writer.Write(&resType.second.length, sizeof(uint32_t));
+        writer.Write(&resType.second.count, sizeof(uint32_t));
         for (const auto &resIndex : resType.second.resIndexs) {
             uint32_t realOffset = idOffsetMap.find(resIndex.second.resId)->second;
-            idSetBlock.write(reinterpret_cast<const char *>(&resIndex.second.resId), sizeof(uint32_t));
-            idSetBlock.write(reinterpret_cast<const char *>(&realOffset), sizeof(uint32_t));
-            idSetBlock.write(reinterpret_cast<const char *>(&resIndex.second.length), sizeof(uint32_t));
-            idSetBlock.write(reinterpret_cast<const char *>(
-                resIndex.second.name.c_str()), resIndex.second.length);
+            writer.Write(&resIndex.second.resId, sizeof(uint32_t));
+            writer.Write(&realOffset, sizeof(uint32_t));
+            writer.Write(&resIndex.second.length, sizeof(uint32_t));
+            writer.Write(resIndex.second.name.c_str(), resIndex.second.length);
         }
     }
 }
 
-void ResourceTable::WriteResHeader(ostringstream &resHeaderBlock, const IndexHeaderV2 &indexHeader)
+void ResourceTable::WriteResHeader(IndexWriter &writer, const IndexHeaderV2 &indexHeader)
 {
-    resHeaderBlock.write(reinterpret_cast<const char *>(indexHeader.version), VERSION_MAX_LEN);
-    resHeaderBlock.write(reinterpret_cast<const char *>(&indexHeader.length), sizeof(uint32_t));
-    resHeaderBlock.write(reinterpret_cast<const char *>(&indexHeader.keyCount), sizeof(uint32_t));
-    resHeaderBlock.write(reinterpret_cast<const char *>(&indexHeader.dataBlockOffset), sizeof(uint32_t));
+    writer.Write(indexHeader.version, VERSION_MAX_LEN);
+    writer.Write(&indexHeader.length, sizeof(uint32_t));
+    writer.Write(&indexHeader.keyCount, sizeof(uint32_t));
+    writer.Write(&indexHeader.dataBlockOffset, sizeof(uint32_t));
     for (const auto &keyConfig : indexHeader.keyConfigs) {
-        resHeaderBlock.write(reinterpret_cast<const char *>(keyConfig.second.keyTag), TAG_LEN);
-        resHeaderBlock.write(reinterpret_cast<const char *>(&keyConfig.second.configId), sizeof(uint32_t));
-        resHeaderBlock.write(reinterpret_cast<const char *>(&keyConfig.second.keyCount), sizeof(uint32_t));
+        writer.Write(keyConfig.second.keyTag, TAG_LEN);
+        writer.Write(&keyConfig.second.configId, sizeof(uint32_t));
+        writer.Write(&keyConfig.second.keyCount, sizeof(uint32_t));
         for (const auto &config : keyConfig.second.configs) {
-            resHeaderBlock.write(reinterpret_cast<const char *>(&config.keyType), sizeof(int32_t));
-            resHeaderBlock.write(reinterpret_cast<const char *>(&config.value), sizeof(int32_t));
+            writer.Write(&config.keyType, sizeof(int32_t));
+            writer.Write(&config.value, sizeof(int32_t));
         }
     }
 }
 
-void ResourceTable::WriteToIndex(const IndexHeaderV2 &indexHeader, const IdSetHeader &idSetHeader,
-    const DataHeader &dataHeader, const ostringstream &dataPool, ofstream &out)
+bool ResourceTable::WriteToIndex(const IndexHeaderV2 &indexHeader, const IdSetHeader &idSetHeader,
+    const DataHeader &dataHeader, const map<string, vector<TableData>> &configs, IndexWriter &writer)
 {
-    ostringstream dataBlock;
+    // layout: | header | IDSS block | DATA block | data pool |, every offset is known before writing
     unordered_map<uint32_t, uint32_t> idOffsetMap;
-    WriteResInfo(dataBlock, dataHeader, indexHeader.dataBlockOffset, idOffsetMap);
-
-    ostringstream idSetBlock;
-    WriteIdSet(idSetBlock, idSetHeader, idOffsetMap);
+    idOffsetMap.reserve(dataHeader.idCount);
+    WriteResInfo(writer, dataHeader, indexHeader.dataBlockOffset, idOffsetMap);
+    WriteDataPool(writer, configs);
 
-    ostringstream resHeaderBlock;
-    WriteResHeader(resHeaderBlock, indexHeader);
-
-    out << resHeaderBlock.str();
-    out << idSetBlock.str();
-    out << dataBlock.str();
-    out << dataPool.str();
+    writer.Seek(0);
+    WriteResHeader(writer, indexHeader);
+    WriteIdSet(writer, idSetHeader, idOffsetMap);
+    return !writer.IsOverflow();
 }
 
 uint32_t ResourceTable::SaveToNewResouorceIndex(const map<string, vector<TableData>> &configs) const
@@ -438,10 +445,9 @@ uint32_t ResourceTable::SaveToNewResouorceIndex(const map<string, vector<TableDa
     DataHeader dataHeader;
 
     if (!InitHeader(indexHeader, idSetHeader, dataHeader, configs.size())) {
-        return false;
+        return RESTOOL_ERROR;
     }
 
-    ostringstream dataPool;
     uint32_t dataPoolLen = 0;
     uint32_t configId = 0;
     for (const auto &config : configs) {
@@ -449,7 +455,7 @@ uint32_t ResourceTable::SaveToNewResouorceIndex(const map<string, vector<TableDa
         for (const auto &tableData : config.second) {
             PrepareResIndex(idSetHeader, tableData);
             PrepareResInfo(dataHeader, tableData.id, configId, dataPoolLen);
-            WriteDataPool(dataPool, tableData.resourceItem, dataPoolLen);
+            dataPoolLen += sizeof(uint16_t) + tableData.resourceItem.GetDataLength();
         }
         configId++;
     }
@@ -457,12 +463,30 @@ uint32_t ResourceTable::SaveToNewResouorceIndex(const map<string, vector<TableDa
     indexHeader.dataBlockOffset = indexHeader.length + idSetHeader.length;
     indexHeader.length += idSetHeader.length + dataHeader.length + dataPoolLen;
 
-    ofstream out(indexFilePath_, ofstream::out | ofstream::binary);
-    if (!out.is_open()) {
-        PrintError(GetError(ERR_CODE_OPEN_FILE_ERROR).FormatCause(indexFilePath_.c_str(), strerror(errno)));
+    IndexWriter writer(indexHeader.length);
+    if (!writer.IsValid()) {
+        PrintError(GetError(ERR_CODE_UNDEFINED_ERROR).FormatCause("failed to allocate the index buffer")
+            .SetPosition(indexFilePath_));
+        return RESTOOL_ERROR;
+    }
+    if (!WriteToIndex(indexHeader, idSetHeader, dataHeader, configs, writer)) {
+        PrintError(GetError(ERR_CODE_UNDEFINED_ERROR).FormatCause("index block exceeds the precomputed length")
+            .SetPosition(indexFilePath_));
+        return RESTOOL_ERROR;
+    }
+    if (writer.GetSize() != writer.GetCapacity()) {
+        PrintError(GetError(ERR_CODE_UNDEFINED_ERROR).FormatCause("index blocks do not fill the precomputed length")
+            .SetPosition(indexFilePath_));
+        return RESTOOL_ERROR;
+    }
+
+    size_t written = 0;
+    if (!OutputSink::GetInstance().Write(indexFilePath_, reinterpret_cast<const char *>(writer.GetData()),
+        writer.GetSize(), written)) {
         return RESTOOL_ERROR;
     }
-    WriteToIndex(indexHeader, idSetHeader, dataHeader, dataPool, out);
+    cout << "Info: write " << RESOURCE_INDEX_FILE << ", bytes written: " << written
+        << ", peak buffer size: " << writer.GetCapacity() << endl;
     return RESTOOL_SUCCESS;
 }
 
@@ -585,361 +609,6 @@ void ResourceTable::SaveIdSets(const map<string, IdSet> &idSets, ostringstream &
         }
     }
 }
-
-bool ResourceTable::ReadFileHeader(basic_istream<char> &in, IndexHeader &indexHeader, uint64_t &pos, uint64_t length)
-{
-    pos += sizeof(indexHeader);
-    if (pos > length) {
-        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("header length error"));
-        return false;
-    }
-    in.read(reinterpret_cast<char *>(indexHeader.version), VERSION_MAX_LEN);
-    in.read(reinterpret_cast<char *>(&indexHeader.fileSize), sizeof(uint32_t));
-    in.read(reinterpret_cast<char *>(&indexHeader.limitKeyConfigSize), sizeof(uint32_t));
-    return true;
-}
-
-bool ResourceTable::ReadLimitKeys(basic_istream<char> &in, map<int64_t, vector<KeyParam>> &limitKeys,
-                                  uint32_t count, uint64_t &pos, uint64_t length)
-{
-    for (uint32_t i = 0; i< count; i++) {
-        pos = pos + TAG_LEN + sizeof(uint32_t) + sizeof(uint32_t);
-        if (pos > length) {
-            PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("KEYS length error"));
-            return false;
-        }
-        LimitKeyConfig limitKey;
-        in.read(reinterpret_cast<char *>(limitKey.keyTag), TAG_LEN);
-        string keyTag(reinterpret_cast<const char *>(limitKey.keyTag), TAG_LEN);
-        if (keyTag != "KEYS") {
-            PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX)
-                .FormatCause(string("invalid key tag = " + keyTag).c_str()));
-            return false;
-        }
-        in.read(reinterpret_cast<char *>(&limitKey.offset), sizeof(uint32_t));
-        in.read(reinterpret_cast<char *>(&limitKey.keyCount), sizeof(uint32_t));
-
-        vector<KeyParam> keyParams;
-        for (uint32_t j = 0; j < limitKey.keyCount; j++) {
-            pos = pos + sizeof(uint32_t) + sizeof(uint32_t);
-            if (pos > length) {
-                PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("keyParams length error"));
-                return false;
-            }
-            KeyParam keyParam;
-            in.read(reinterpret_cast<char *>(&keyParam.keyType), sizeof(uint32_t));
-            in.read(reinterpret_cast<char *>(&keyParam.value), sizeof(uint32_t));
-            keyParams.push_back(keyParam);
-        }
-        limitKeys[limitKey.offset] = keyParams;
-    }
-    return true;
-}
-
-bool ResourceTable::ReadIdTables(basic_istream<char> &in, std::map<int64_t, std::pair<int64_t, int64_t>> &datas,
-                                 uint32_t count, uint64_t &pos, uint64_t length)
-{
-    for (uint32_t i = 0; i< count; i++) {
-        pos = pos + TAG_LEN + sizeof(uint32_t);
-        if (pos > length) {
-            PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("IDSS length error"));
-            return false;
-        }
-        IdSet idss;
-        int64_t offset = in.tellg();
-        in.read(reinterpret_cast<char *>(idss.idTag), TAG_LEN);
-        string idTag(reinterpret_cast<const char *>(idss.idTag), TAG_LEN);
-        if (idTag != "IDSS") {
-            PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX)
-                .FormatCause(string("invalid id tag = " + idTag).c_str()));
-            return false;
-        }
-        in.read(reinterpret_cast<char *>(&idss.idCount), sizeof(uint32_t));
-
-        for (uint32_t j = 0; j < idss.idCount; j++) {
-            pos = pos + sizeof(uint32_t) + sizeof(uint32_t);
-            if (pos > length) {
-                PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("id data length error"));
-                return false;
-            }
-            IdData data;
-            in.read(reinterpret_cast<char *>(&data.id), sizeof(uint32_t));
-            in.read(reinterpret_cast<char *>(&data.dataOffset), sizeof(uint32_t));
-            datas[data.dataOffset] = make_pair(data.id, offset);
-        }
-    }
-    return true;
-}
-
-bool ResourceTable::ReadDataRecordPrepare(basic_istream<char> &in, RecordItem &record, uint64_t &pos, uint64_t length)
-{
-    pos = pos + sizeof(uint32_t);
-    if (pos > length) {
-        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("data record length error"));
-        return false;
-    }
-    in.read(reinterpret_cast<char *>(&record.size), sizeof(uint32_t));
-    pos = pos + record.size;
-    if (pos > length) {
-        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("record.size length error"));
-        return false;
-    }
-    in.read(reinterpret_cast<char *>(&record.resType), sizeof(uint32_t));
-    in.read(reinterpret_cast<char *>(&record.id), sizeof(uint32_t));
-    return true;
-}
-
-bool ResourceTable::ReadDataRecordStart(basic_istream<char> &in, RecordItem &record,
-                                        const map<int64_t, vector<KeyParam>> &limitKeys,
-                                        const map<int64_t, pair<int64_t, int64_t>> &datas,
-                                        map<int64_t, vector<ResourceItem>> &resInfos)
-{
-    int64_t offset = in.tellg();
-    offset = offset - sizeof(uint32_t) - sizeof(uint32_t) - sizeof(uint32_t);
-    uint16_t value_size = 0;
-    in.read(reinterpret_cast<char *>(&value_size), sizeof(uint16_t));
-    if (value_size + sizeof(uint16_t) > record.size) {
-        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("value size error"));
-        return false;
-    }
-    int8_t values[value_size];
-    in.read(reinterpret_cast<char *>(&values), value_size);
-
-    uint16_t name_size = 0;
-    in.read(reinterpret_cast<char *>(&name_size), sizeof(uint16_t));
-    if (value_size + sizeof(uint16_t) + name_size + sizeof(uint16_t) > record.size) {
-        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("name size error"));
-        return false;
-    }
-    int8_t name[name_size];
-    in.read(reinterpret_cast<char *>(name), name_size);
-    string filename(reinterpret_cast<char *>(name));
-
-    auto idTableOffset = datas.find(offset);
-    if (idTableOffset == datas.end()) {
-        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("invalid id offset"));
-        return false;
-    }
-
-    if (idTableOffset->second.first != record.id) {
-        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("invalid id"));
-        return false;
-    }
-
-    if (limitKeys.find(idTableOffset->second.second) == limitKeys.end()) {
-        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("invalid limit key offset"));
-        return false;
-    }
-
-    const vector<KeyParam> &keyparams = limitKeys.find(datas.find(offset)->second.second)->second;
-    ResourceItem resourceitem(filename, keyparams, g_resTypeMap.find(record.resType)->second);
-    resourceitem.SetLimitKey(ResourceUtil::PaserKeyParam(keyparams));
-    resourceitem.SetData(values, value_size);
-    resourceitem.MarkCoverable();
-    resInfos[record.id].push_back(resourceitem);
-    return true;
-}
-
-bool ResourceTable::IsNewModule(const IndexHeader &indexHeader)
-{
-    string version = string(reinterpret_cast<const char *>(indexHeader.version), VERSION_MAX_LEN);
-    if (version.substr(0, version.find(" ")) == "Restool") {
-        return false;
-    }
-    return true;
-}
-
-uint32_t ResourceTable::LoadNewResTable(basic_istream<char> &in, map<int64_t, vector<ResourceItem>> &resInfos)
-{
-    if (!in) {
-        std::string msg = "file stream bad, state code: " + std::to_string(in.rdstate());
-        PrintError(GetError(ERR_CODE_READ_FILE_ERROR).FormatCause(in.rdstate(), msg.c_str()));
-        return RESTOOL_ERROR;
-    }
-    in.seekg(0, ios::end);
-    int64_t length = in.tellg();
-    in.seekg(0, ios::beg);
-    uint64_t pos = 0;
-    IndexHeaderV2 indexHeader;
-    if (!ReadNewFileHeader(in, indexHeader, pos, static_cast<uint64_t>(length))) {
-        return RESTOOL_ERROR;
-    }
-    IdSetHeader idSetHeader;
-    if (!ReadIdSetHeader(in, idSetHeader, pos, static_cast<uint64_t>(length))) {
-        return RESTOOL_ERROR;
-    }
-    for (const auto &resType : idSetHeader.resTypes) {
-        for (const auto &resId : resType.second.resIndexs) {
-            ReadResources(in, resId.second, resType.second, indexHeader, static_cast<uint64_t>(length), resInfos);
-        }
-    }
-    return RESTOOL_SUCCESS;
-}
-
-bool ResourceTable::ReadNewFileHeader(basic_istream<char> &in, IndexHeaderV2 &indexHeader,
-    uint64_t &pos, uint64_t length)
-{
-    pos += IndexHeaderV2::INDEX_HEADER_LEN;
-    if (pos > length) {
-        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("header length error"));
-        return false;
-    }
-    in.read(reinterpret_cast<char *>(indexHeader.version), VERSION_MAX_LEN);
-    in.read(reinterpret_cast<char *>(&indexHeader.length), sizeof(uint32_t));
-    in.read(reinterpret_cast<char *>(&indexHeader.keyCount), sizeof(uint32_t));
-    in.read(reinterpret_cast<char *>(&indexHeader.dataBlockOffset), sizeof(uint32_t));
-
-    for (uint32_t key = 0; key < indexHeader.keyCount; key++) {
-        pos += KeyConfig::KEY_CONFIG_HEADER_LEN;
-        if (pos > length) {
-            PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("KeyConfig header length error"));
-            return false;
-        }
-        KeyConfig keyConfig;
-        in.read(reinterpret_cast<char *>(keyConfig.keyTag), TAG_LEN);
-        in.read(reinterpret_cast<char *>(&keyConfig.configId), sizeof(uint32_t));
-        in.read(reinterpret_cast<char *>(&keyConfig.keyCount), sizeof(uint32_t));
-
-        for (uint32_t keyType = 0; keyType < keyConfig.keyCount; keyType++) {
-            pos += KeyParam::KEY_PARAM_LEN;
-            if (pos > length) {
-                PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("KeyParam length error"));
-                return false;
-            }
-            KeyParam keyParam;
-            in.read(reinterpret_cast<char *>(&keyParam.keyType), sizeof(uint32_t));
-            in.read(reinterpret_cast<char *>(&keyParam.value), sizeof(uint32_t));
-            keyConfig.configs.push_back(keyParam);
-        }
-        indexHeader.idKeyConfigs[keyConfig.configId] = keyConfig;
-    }
-    return true;
-}
-
-bool ResourceTable::ReadIdSetHeader(basic_istream<char> &in, IdSetHeader &idSetHeader, uint64_t &pos, uint64_t length)
-{
-    pos += IdSetHeader::ID_SET_HEADER_LEN;
-    if (pos > length) {
-        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("IdSet header length error"));
-        return false;
-    }
-    in.read(reinterpret_cast<char *>(idSetHeader.idTag), TAG_LEN);
-    in.read(reinterpret_cast<char *>(&idSetHeader.length), sizeof(uint32_t));
-    in.read(reinterpret_cast<char *>(&idSetHeader.typeCount), sizeof(uint32_t));
-    in.read(reinterpret_cast<char *>(&idSetHeader.idCount), sizeof(uint32_t));
-
-    for (uint32_t resType = 0; resType < idSetHeader.typeCount; resType++) {
-        pos += ResTypeHeader::RES_TYPE_HEADER_LEN;
-        if (pos > length) {
-            PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("ResType header length error"));
-            return false;
-        }
-        ResTypeHeader resTypeHeader;
-        in.read(reinterpret_cast<char *>(&resTypeHeader.resType), sizeof(uint32_t));
-        in.read(reinterpret_cast<char *>(&resTypeHeader.length), sizeof(uint32_t));
-        in.read(reinterpret_cast<char *>(&resTypeHeader.count), sizeof(uint32_t));
-
-        for (uint32_t resId = 0; resId < resTypeHeader.count; resId++) {
-            pos += ResIndex::RES_INDEX_LEN;
-            if (pos > length) {
-                PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("ResIndex length error"));
-                return false;
-            }
-            ResIndex resIndex;
-            in.read(reinterpret_cast<char *>(&resIndex.resId), sizeof(uint32_t));
-            in.read(reinterpret_cast<char *>(&resIndex.offset), sizeof(uint32_t));
-            in.read(reinterpret_cast<char *>(&resIndex.length), sizeof(uint32_t));
-            pos += resIndex.length;
-            if (pos > length) {
-                PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("resource name length error"));
-                return false;
-            }
-            char *name = new char[resIndex.length + 1]();
-            in.read(name, resIndex.length);
-            resIndex.name = string(name, resIndex.length);
-            delete[] name;
-
-            resTypeHeader.resIndexs[resIndex.resId] = resIndex;
-        }
-        idSetHeader.resTypes[resTypeHeader.resType] = resTypeHeader;
-    }
-    return true;
-}
-
-bool ResourceTable::ReadResources(std::basic_istream<char> &in, const ResIndex &resIndex,
-    const ResTypeHeader &resTypeHeader, IndexHeaderV2 &indexHeader, uint64_t length,
-    map<int64_t, vector<ResourceItem>> &resInfos)
-{
-    ResInfo resInfo;
-    if (!ReadResInfo(in, resInfo, resIndex.offset, length)) {
-        return RESTOOL_ERROR;
-    }
-    uint64_t pos = resIndex.offset + ResInfo::RES_INFO_LEN;
-    for (uint32_t resConfig = 0; resConfig < resInfo.valueCount; resConfig++) {
-        uint32_t resConfigId;
-        uint32_t dataOffset;
-        if (!ReadResConfig(in, resConfigId, dataOffset, pos, length)) {
-            return RESTOOL_ERROR;
-        }
-        ResourceItem resourceItem(resIndex.name, indexHeader.idKeyConfigs[resConfigId].configs,
-            resTypeHeader.resType);
-        resourceItem.SetLimitKey(ResourceUtil::PaserKeyParam(indexHeader.idKeyConfigs[resConfigId].configs));
-        if (!ReadResourceItem(in, resourceItem, dataOffset, pos, length)) {
-            return RESTOOL_ERROR;
-        }
-        resInfos[resIndex.resId].push_back(resourceItem);
-    }
-    return true;
-}
-
-bool ResourceTable::ReadResInfo(std::basic_istream<char> &in, ResInfo &resInfo, uint32_t offset, uint64_t length)
-{
-    in.seekg(offset, ios::beg);
-    if (offset + ResInfo::RES_INFO_LEN > length) {
-        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("ResInfo length error"));
-        return false;
-    }
-    in.read(reinterpret_cast<char *>(&resInfo.resId), sizeof(uint32_t));
-    in.read(reinterpret_cast<char *>(&resInfo.length), sizeof(uint32_t));
-    in.read(reinterpret_cast<char *>(&resInfo.valueCount), sizeof(uint32_t));
-    return true;
-}
-
-bool ResourceTable::ReadResConfig(std::basic_istream<char> &in, uint32_t &resConfigId, uint32_t &dataOffset,
-    uint64_t &pos, uint64_t length)
-{
-    in.seekg(pos, ios::beg);
-    pos += sizeof(uint32_t) + sizeof(uint32_t);
-    if (pos > length) {
-        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("Config id length error"));
-        return false;
-    }
-    in.read(reinterpret_cast<char *>(&resConfigId), sizeof(uint32_t));
-    in.read(reinterpret_cast<char *>(&dataOffset), sizeof(uint32_t));
-    return true;
-}
-
-bool ResourceTable::ReadResourceItem(std::basic_istream<char> &in, ResourceItem &resourceItem,
-    uint32_t dataOffset, uint64_t &pos, uint64_t length)
-{
-    if (dataOffset + sizeof(uint16_t) > length) {
-        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("resource length error"));
-        return false;
-    }
-    in.seekg(dataOffset, ios::beg);
-    uint16_t dataLen;
-    in.read(reinterpret_cast<char *>(&dataLen), sizeof(uint16_t));
-    if (dataOffset + sizeof(uint16_t) + dataLen > length) {
-        PrintError(GetError(ERR_CODE_INVALID_RESOURCE_INDEX).FormatCause("resource length error"));
-        return false;
-    }
-    int8_t data[dataLen + 1];
-    in.read(reinterpret_cast<char *>(data), dataLen);
-
-    resourceItem.SetData(data, dataLen + 1);
-    resourceItem.MarkCoverable();
-    return true;
-}
 }
 }
 }
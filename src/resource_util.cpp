@@ -24,7 +24,10 @@
 #include <regex>
 #include <sstream>
 #include "file_entry.h"
+#include "ignore_matcher.h"
+#include "output_sink.h"
 #include "restool_errors.h"
+#include "sharded_set.h"
 
 namespace OHOS {
 namespace Global {
@@ -43,13 +46,13 @@ const map<string, IgnoreType> ResourceUtil::DEFAULT_IGNORE_FILE_REGEX = {
     { ".+~", IgnoreType::IGNORE_ALL }
 };
 const std::set<std::string> IGNORE_PATH_OPTIONS = { "--ignored-path", "ignoreResourcePathPattern" };
-static std::map<std::string, IgnoreType> g_userIgnoreRegex;
+static IgnoreMatcher g_userIgnoreMatcher;
 static bool g_isUseCustomRegex = false;
 static std::string g_ignoreOption;
 static bool g_isIgnorePath = false;
 static std::set<int64_t> g_harResourceIds;
 
-static std::mutex fileMutex_;
+static ShardedSet g_createdDirs;
 static std::mutex g_harResourceMutex;
 
 void ResourceUtil::Split(const string &str, vector<string> &out, const string &splitter)
@@ -79,6 +82,8 @@ bool ResourceUtil::FileExist(const string &path)
 
 bool ResourceUtil::RmoveAllDir(const string &path)
 {
+    // directories created before may be under the path
+    g_createdDirs.Clear();
     return FileEntry::RemoveAllDir(path);
 }
 
@@ -89,7 +94,7 @@ bool ResourceUtil::RmoveFile(const string &path)
 
 bool ResourceUtil::OpenJsonFile(const string &path, cJSON **root, const bool &printError)
 {
-    ifstream ifs(FileEntry::AdaptLongPath(path), ios::binary);
+    ifstream ifs(FileEntry::AdaptLongPath(path), ios::binary | ios::ate);
     if (!ifs.is_open()) {
         if (printError) {
             PrintError(GetError(ERR_CODE_OPEN_JSON_FAIL).FormatCause(path.c_str(), strerror(errno)));
@@ -97,7 +102,12 @@ bool ResourceUtil::OpenJsonFile(const string &path, cJSON **root, const bool &pr
         return false;
     }
 
-    string jsonString((istreambuf_iterator<char>(ifs)), istreambuf_iterator<char>());
+    // read in one call instead of one character at a time
+    streamoff length = ifs.tellg();
+    string jsonString(length > 0 ? static_cast<size_t>(length) : 0, '\0');
+    ifs.seekg(0, ios::beg);
+    ifs.read(&jsonString[0], jsonString.length());
+    jsonString.resize(static_cast<size_t>(ifs.gcount()));
     *root = cJSON_Parse(jsonString.c_str());
     if (!*root) {
         if (printError) {
@@ -112,17 +122,14 @@ bool ResourceUtil::OpenJsonFile(const string &path, cJSON **root, const bool &pr
 
 bool ResourceUtil::SaveToJsonFile(const string &path, const cJSON *root)
 {
-    ofstream out(FileEntry::AdaptLongPath(path), ofstream::out | ofstream::binary);
-    if (!out.is_open()) {
-        PrintError(GetError(ERR_CODE_OPEN_FILE_ERROR).FormatCause(path.c_str(), strerror(errno)));
+    char *jsonString = cJSON_Print(root);
+    if (jsonString == nullptr) {
+        PrintError(GetError(ERR_CODE_UNDEFINED_ERROR).FormatCause("failed to print json").SetPosition(path));
         return false;
     }
-    char *jsonString = cJSON_Print(root);
-    out << jsonString;
+    bool ret = OutputSink::GetInstance().Write(path, jsonString, strlen(jsonString));
     cJSON_free(jsonString);
-    jsonString = nullptr;
-    out.close();
-    return true;
+    return ret;
 }
 
 ResType ResourceUtil::GetResTypeByDir(const string &name)
@@ -240,58 +247,60 @@ ResType ResourceUtil::GetResTypeFromString(const string &type)
 
 bool ResourceUtil::CopyFileInner(const string &src, const string &dst)
 {
-    return FileEntry::CopyFileInner(src, dst);
+    return OutputSink::GetInstance().Copy(src, dst);
 }
 
 bool ResourceUtil::CreateDirs(const string &filePath)
 {
-    std::lock_guard<std::mutex> lock(fileMutex_);
-    if (FileExist(filePath)) {
+    ShardedSet::Key key = ShardedSet::MakeKey(filePath);
+    if (g_createdDirs.Contains(key)) {
         return true;
     }
-
     if (!FileEntry::CreateDirs(filePath)) {
         PrintError(GetError(ERR_CODE_CREATE_FILE_ERROR).FormatCause(filePath.c_str(), strerror(errno)));
         return false;
     }
+    g_createdDirs.Insert(key);
     return true;
 }
 
 bool ResourceUtil::IsIgnoreFile(const FileEntry &fileEntry)
 {
-    map<string, IgnoreType> regexs;
-    std::string regexSources;
+    static const IgnoreMatcher defaultIgnoreMatcher(DEFAULT_IGNORE_FILE_REGEX);
     string fileName = fileEntry.GetFilePath().GetFilename();
-    string filePath = fileEntry.GetFilePath().GetPath();
-    filePath = regex_replace(filePath, regex("\\\\+"), "/");
-    if (g_isUseCustomRegex) {
-        regexs = g_userIgnoreRegex;
-        regexSources = "user";
-    } else {
-        regexs = DEFAULT_IGNORE_FILE_REGEX;
+    string filePath;
+    bool matchPath = g_isUseCustomRegex && g_isIgnorePath;
+    if (matchPath) {
+        // same as regex_replace(path, regex("\\\\+"), "/")
+        const string &path = fileEntry.GetFilePath().GetPath();
+        filePath.reserve(path.length());
+        for (size_t i = 0; i < path.length(); i++) {
+            if (path[i] != '\\') {
+                filePath.push_back(path[i]);
+            } else if (i == 0 || path[i - 1] != '\\') {
+                filePath.push_back('/');
+            }
+        }
+    }
+    const IgnoreMatcher *matcher = &g_userIgnoreMatcher;
+    std::string regexSources = "user";
+    if (!g_isUseCustomRegex) {
+        matcher = &defaultIgnoreMatcher;
         regexSources = "default";
         transform(fileName.begin(), fileName.end(), fileName.begin(), ::tolower);
     }
-    bool isFile = fileEntry.IsFile();
-    for (const auto &iter : regexs) {
-        if ((iter.second == IgnoreType::IGNORE_FILE && !isFile) || (iter.second == IgnoreType::IGNORE_DIR && isFile)) {
-            continue;
-        }
-        if (regex_match(fileName, regex(iter.first))) {
-            cout << "Info: file '" << fileName << "' is ignored by " << regexSources << " filename pattern '"
-                 << iter.first << "'." << endl;
-            return true;
-        }
-
-        if (g_isUseCustomRegex && g_isIgnorePath) {
-            if (regex_match(filePath, regex(iter.first))) {
-                cout << "Info: file '" << filePath << "' is ignored by " << regexSources << " filepath pattern '"
-                     << iter.first << "'." << endl;
-                return true;
-            }
-        }
+    IgnoreMatcher::MatchResult result = matcher->Match(fileName, filePath, fileEntry.IsFile(), matchPath);
+    if (result.pattern == nullptr) {
+        return false;
     }
-    return false;
+    if (result.isPath) {
+        cout << "Info: file '" << filePath << "' is ignored by " << regexSources << " filepath pattern '"
+             << *result.pattern << "'." << endl;
+    } else {
+        cout << "Info: file '" << fileName << "' is ignored by " << regexSources << " filename pattern '"
+             << *result.pattern << "'." << endl;
+    }
+    return true;
 }
 
 string ResourceUtil::GenerateHash(const string &key)
@@ -430,7 +439,8 @@ string ResourceUtil::DecToHexStr(const uint32_t i)
 
 bool ResourceUtil::CheckHexStr(const string &hex)
 {
-    if (regex_match(hex, regex("^0[xX][0-9a-fA-F]{8}"))) {
+    static const regex hexStr("^0[xX][0-9a-fA-F]{8}");
+    if (regex_match(hex, hexStr)) {
         return true;
     }
     return false;
@@ -514,10 +524,13 @@ bool ResourceUtil::IsIntValue(const cJSON *node)
 
 bool ResourceUtil::IsValidName(const string &name)
 {
-    if (!regex_match(name, regex("[a-zA-Z0-9_]+"))) {
+    // same as matching [a-zA-Z0-9_]+, a regex compiled for each name was most of the allocations of a pack
+    if (name.empty()) {
         return false;
     }
-    return true;
+    return all_of(name.begin(), name.end(), [](char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    });
 }
 
 void ResourceUtil::PrintWarningMsg(vector<pair<ResType, string>> &noBaseResource)
@@ -542,14 +555,12 @@ string ResourceUtil::KeyTypeToStr(KeyType type)
 
 bool ResourceUtil::AddIgnoreRegex(const std::string &regex, IgnoreType ignoreType, const std::string &option)
 {
-    try {
-        std::regex rg(regex);
-    } catch (std::regex_error err) {
-        PrintError(GetError(ERR_CODE_INVALID_IGNORE_FILE).FormatCause(regex.c_str(), err.what())
+    std::string errMsg;
+    if (!g_userIgnoreMatcher.AddPattern(regex, ignoreType, errMsg)) {
+        PrintError(GetError(ERR_CODE_INVALID_IGNORE_FILE).FormatCause(regex.c_str(), errMsg.c_str())
             .FormatSolution(0, option.c_str()));
         return false;
     }
-    g_userIgnoreRegex[regex] = ignoreType;
     return true;
 }
 
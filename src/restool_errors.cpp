@@ -813,6 +813,31 @@ ErrorInfo GetError(const uint32_t &errCode)
     return error;
 }
 
+static thread_local std::string *g_errorBuffer = nullptr;
+
+std::string *SetErrorBuffer(std::string *buffer)
+{
+    std::string *last = g_errorBuffer;
+    g_errorBuffer = buffer;
+    return last;
+}
+
+static void OutputError(const std::string &errMsg)
+{
+    if (g_errorBuffer) {
+        g_errorBuffer->append(errMsg);
+        return;
+    }
+    std::cerr << errMsg;
+}
+
+void PrintErrors(const std::string &errors)
+{
+    if (!errors.empty()) {
+        OutputError(errors);
+    }
+}
+
 void PrintError(const uint32_t &errCode)
 {
     PrintError(GetError(errCode));
@@ -829,7 +854,7 @@ void PrintError(const ErrorInfo &error)
     }
     errMsg.append("\n");
     if (error.solutions_.empty()) {
-        std::cerr << errMsg;
+        OutputError(errMsg);
         return;
     }
     errMsg.append("* Try the following:").append("\n");
@@ -867,7 +892,7 @@ void PrintError(const ErrorInfo &error)
         errMsg.append("  > More info: ").append(moreInfo).append("\n");
     }
     errMsg = FileEntry::Utf8ToSysDefault(errMsg);
-    std::cerr << errMsg;
+    OutputError(errMsg);
 }
 } // namespace Restool
 } // namespace Global
@@ -95,7 +95,7 @@ bool SelectCompileParse::CheckTargetConfig(const std::string &limitParams)
     return true;
 }
 
-bool SelectCompileParse::IsSelectCompile(vector<KeyParam> &keyParams)
+bool SelectCompileParse::IsSelectCompile(const vector<KeyParam> &keyParams)
 {
     if (keyParams.empty()) {
         return true;
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sharded_set.h"
+#include <functional>
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+using namespace std;
+ShardedSet g_resourceSet;
+ShardedSet g_hapResourceSet;
+
+ShardedSet::Key ShardedSet::MakeKey(string value)
+{
+    size_t hash = std::hash<string>()(value);
+    return { move(value), hash };
+}
+
+bool ShardedSet::Insert(const Key &key)
+{
+    Shard &shard = GetShard(key.hash);
+    lock_guard<mutex> lock(shard.mutex);
+    return shard.keys.insert(key).second;
+}
+
+bool ShardedSet::Erase(const Key &key)
+{
+    Shard &shard = GetShard(key.hash);
+    lock_guard<mutex> lock(shard.mutex);
+    return shard.keys.erase(key) > 0;
+}
+
+bool ShardedSet::Contains(const Key &key) const
+{
+    const Shard &shard = GetShard(key.hash);
+    lock_guard<mutex> lock(shard.mutex);
+    return shard.keys.count(key) > 0;
+}
+
+size_t ShardedSet::Size() const
+{
+    size_t size = 0;
+    for (const auto &shard : shards_) {
+        lock_guard<mutex> lock(shard.mutex);
+        size += shard.keys.size();
+    }
+    return size;
+}
+
+void ShardedSet::Clear()
+{
+    for (auto &shard : shards_) {
+        lock_guard<mutex> lock(shard.mutex);
+        shard.keys.clear();
+    }
+}
+
+// below private
+ShardedSet::Shard &ShardedSet::GetShard(size_t hash)
+{
+    return shards_[GetShardIndex(hash)];
+}
+
+const ShardedSet::Shard &ShardedSet::GetShard(size_t hash) const
+{
+    return shards_[GetShardIndex(hash)];
+}
+
+size_t ShardedSet::GetShardIndex(size_t hash)
+{
+    // the high bits pick the shard, the low bits are left to the buckets of the shard
+    return (hash >> (sizeof(size_t) * 8 - SHARD_BITS)) & (SHARD_COUNT - 1); // 8 bits per byte
+}
+}
+}
+}
@@ -18,11 +18,16 @@
 #include "restool_errors.h"
 #include <iostream>
 #include <string>
+#include "tracer.h"
 
 namespace OHOS {
 namespace Global {
 namespace Restool {
 using namespace std;
+namespace {
+thread_local const ThreadPool *g_currentPool = nullptr;
+thread_local size_t g_workerIndex = 0;
+}
 
 ThreadPool::ThreadPool()
 {}
@@ -47,9 +52,13 @@ uint32_t ThreadPool::Start(const size_t &threadCount)
     }
     cout << "Info: thread count is : " << count << endl;
     running_ = true;
+    workers_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
     workerThreads_.reserve(count);
     for (size_t i = 0; i < count; ++i) {
-        workerThreads_.emplace_back([this] { this->WorkInThread(); });
+        workerThreads_.emplace_back([this, i] { this->WorkInThread(i); });
     }
     cout << "Info: thread pool is started" << endl;
     return RESTOOL_SUCCESS;
@@ -78,27 +87,160 @@ ThreadPool::~ThreadPool()
     }
 }
 
-void ThreadPool::WorkInThread()
+size_t ThreadPool::GetThreadCount() const
+{
+    return workers_.size();
+}
+
+bool ThreadPool::RunPendingTask()
+{
+    std::function<void()> task;
+    if (!Pop(task)) {
+        return false;
+    }
+    RunTask(task);
+    return true;
+}
+
+bool ThreadPool::IsWorker() const
+{
+    return g_currentPool == this;
+}
+
+void ThreadPool::RunTask(std::function<void()> &task)
+{
+    Tracer::GetInstance().AddCounter("pending tasks", static_cast<int64_t>(pending_.load()));
+    TraceScope scope("task", "pool");
+    // a task run by a waiting thread must not report its errors to the buffer of the waiter
+    string *lastBuffer = SetErrorBuffer(nullptr);
+    task();
+    SetErrorBuffer(lastBuffer);
+}
+
+void ThreadPool::Push(std::function<void()> task)
+{
+    // count the task before it is visible, so a thread that takes it never sees pending_ go below zero
+    size_t pending = ++pending_;
+    Tracer::GetInstance().AddCounter("pending tasks", static_cast<int64_t>(pending));
+    if (g_currentPool == this) {
+        Worker &worker = *workers_[g_workerIndex];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    } else {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        tasks_.push_back(std::move(task));
+    }
+    {
+        // pairs with the predicate check of the idle workers, so the notification is not lost
+        std::lock_guard<std::mutex> lock(queueMutex_);
+    }
+    condition_.notify_one();
+}
+
+bool ThreadPool::Pop(std::function<void()> &task)
 {
+    if (pending_ == 0) {
+        return false;
+    }
+    size_t count = workers_.size();
+    bool isWorker = g_currentPool == this;
+    if (isWorker) {
+        Worker &worker = *workers_[g_workerIndex];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (!worker.tasks.empty()) {
+            task = std::move(worker.tasks.back());
+            worker.tasks.pop_back();
+            pending_--;
+            return true;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        if (!tasks_.empty()) {
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+            pending_--;
+            return true;
+        }
+    }
+    size_t start = isWorker ? g_workerIndex + 1 : 0;
+    for (size_t i = 0; i < count; ++i) {
+        Worker &victim = *workers_[(start + i) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            pending_--;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::WorkInThread(size_t index)
+{
+    g_currentPool = this;
+    g_workerIndex = index;
+    Tracer::GetInstance().SetThreadName("worker " + to_string(index));
     while (this->running_) {
-        std::function<void()> task;
+        if (RunPendingTask()) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(this->queueMutex_);
+        // wake up when there's a task or when the pool is stopped
+        this->condition_.wait(lock, [this] { return !this->running_ || this->pending_ > 0; });
+    }
+}
+
+TaskGroup::TaskGroup(ThreadPool &pool) : pool_(pool), state_(std::make_shared<State>())
+{}
+
+TaskGroup::~TaskGroup()
+{
+    Wait();
+}
+
+uint32_t TaskGroup::Wait()
+{
+    while (true) {
         {
-            std::unique_lock<std::mutex> lock(this->queueMutex_);
-            // wake up when there's a task or when the pool is stopped
-            this->condition_.wait(lock, [this] { return !this->running_ || !this->tasks_.empty(); });
-            if (!this->running_) {
-                // exit thread when the pool is stopped
-                return;
+            std::unique_lock<std::mutex> lock(state_->mutex);
+            if (state_->pending == 0) {
+                return state_->failed ? RESTOOL_ERROR : RESTOOL_SUCCESS;
             }
-            if (!this->tasks_.empty()) {
-                task = std::move(this->tasks_.front());
-                this->tasks_.pop();
+            if (state_->tasks.empty()) {
+                // all the tasks are started by other threads, wait for them to finish
+                state_->condition.wait(lock, [this] { return state_->pending == 0 || !state_->tasks.empty(); });
+                continue;
             }
         }
-        if (task) {
-            task();
+        string *lastBuffer = SetErrorBuffer(nullptr);
+        RunNext(*state_);
+        SetErrorBuffer(lastBuffer);
+    }
+}
+
+bool TaskGroup::RunNext(State &state)
+{
+    std::function<uint32_t()> task;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        if (state.tasks.empty()) {
+            // already run by a waiter of the group
+            return false;
         }
+        task = std::move(state.tasks.front());
+        state.tasks.pop_front();
+    }
+    uint32_t result = task();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (result != RESTOOL_SUCCESS) {
+        state.failed = true;
+    }
+    if (--state.pending == 0) {
+        state.condition.notify_all();
     }
+    return true;
 }
 } // namespace Restool
 } // namespace Global
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "tracer.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "file_entry.h"
+#include "restool_errors.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+using namespace std;
+namespace {
+constexpr uint32_t TRACE_PID = 1;
+}
+thread_local Tracer::ThreadBuffer *Tracer::threadBuffer_ = nullptr;
+
+void Tracer::Start(const string &path)
+{
+    if (enabled_) {
+        return;
+    }
+    path_ = path;
+    startTime_ = chrono::steady_clock::now();
+    enabled_.store(true, memory_order_release);
+}
+
+bool Tracer::IsEnabled() const
+{
+    return enabled_.load(memory_order_acquire);
+}
+
+void Tracer::SetThreadName(const string &name)
+{
+    if (!IsEnabled()) {
+        return;
+    }
+    ThreadBuffer &buffer = GetThreadBuffer();
+    lock_guard<mutex> lock(buffer.mutex);
+    buffer.name = name;
+}
+
+void Tracer::AddSpan(const string &name, const char *category, int64_t start, int64_t end)
+{
+    if (!IsEnabled()) {
+        return;
+    }
+    ThreadBuffer &buffer = GetThreadBuffer();
+    lock_guard<mutex> lock(buffer.mutex);
+    buffer.events.push_back({ 'X', category, name, start, end - start });
+}
+
+void Tracer::AddCounter(const char *name, int64_t value)
+{
+    if (!IsEnabled()) {
+        return;
+    }
+    int64_t time = GetTime();
+    ThreadBuffer &buffer = GetThreadBuffer();
+    lock_guard<mutex> lock(buffer.mutex);
+    buffer.events.push_back({ 'C', "counter", name, time, value });
+}
+
+bool Tracer::Save() const
+{
+    if (!IsEnabled()) {
+        return true;
+    }
+    string out = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    {
+        lock_guard<mutex> lock(buffersMutex_);
+        for (const auto &buffer : buffers_) {
+            lock_guard<mutex> bufferLock(buffer->mutex);
+            if (!buffer->name.empty()) {
+                out.append(first ? "" : ",\n");
+                out.append("{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":").append(to_string(TRACE_PID));
+                out.append(",\"tid\":").append(to_string(buffer->tid));
+                out.append(",\"args\":{\"name\":\"").append(Escape(buffer->name)).append("\"}}");
+                first = false;
+            }
+            for (const auto &event : buffer->events) {
+                out.append(first ? "" : ",\n");
+                WriteEvent(out, event, buffer->tid);
+                first = false;
+            }
+        }
+    }
+    out.append("\n]}\n");
+
+    ofstream file(FileEntry::AdaptLongPath(path_), ofstream::out | ofstream::binary);
+    if (!file.is_open()) {
+        PrintError(GetError(ERR_CODE_OPEN_FILE_ERROR).FormatCause(path_.c_str(), strerror(errno)));
+        return false;
+    }
+    file << out;
+    if (!file.good()) {
+        PrintError(GetError(ERR_CODE_CREATE_FILE_ERROR).FormatCause(path_.c_str(), strerror(errno)));
+        return false;
+    }
+    cout << "Info: trace is saved to '" << path_ << "'." << endl;
+    return true;
+}
+
+int64_t Tracer::GetTime() const
+{
+    return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - startTime_).count();
+}
+
+// below private
+Tracer::ThreadBuffer &Tracer::GetThreadBuffer()
+{
+    if (threadBuffer_ == nullptr) {
+        lock_guard<mutex> lock(buffersMutex_);
+        auto buffer = make_unique<ThreadBuffer>();
+        buffer->tid = static_cast<uint32_t>(buffers_.size() + 1);
+        threadBuffer_ = buffer.get();
+        buffers_.push_back(move(buffer));
+    }
+    return *threadBuffer_;
+}
+
+void Tracer::WriteEvent(string &out, const Event &event, uint32_t tid)
+{
+    out.append("{\"ph\":\"").append(1, event.phase).append("\",\"cat\":\"").append(event.category);
+    out.append("\",\"name\":\"").append(Escape(event.name)).append("\",\"pid\":").append(to_string(TRACE_PID));
+    out.append(",\"tid\":").append(to_string(tid)).append(",\"ts\":").append(to_string(event.time));
+    if (event.phase == 'X') {
+        out.append(",\"dur\":").append(to_string(event.value)).append("}");
+    } else {
+        out.append(",\"args\":{\"value\":").append(to_string(event.value)).append("}}");
+    }
+}
+
+string Tracer::Escape(const string &str)
+{
+    string res;
+    res.reserve(str.size());
+    for (char c : str) {
+        if (c == '"' || c == '\\') {
+            res.push_back('\\');
+            res.push_back(c);
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char buffer[8]; // \u00XX and the terminator
+            snprintf(buffer, sizeof(buffer), "\\u%04x", static_cast<unsigned char>(c));
+            res.append(buffer);
+        } else {
+            res.push_back(c);
+        }
+    }
+    return res;
+}
+
+TraceScope::TraceScope(const char *name, const char *category) : category_(category)
+{
+    if (Tracer::GetInstance().IsEnabled()) {
+        name_ = name;
+        start_ = Tracer::GetInstance().GetTime();
+    }
+}
+
+TraceScope::TraceScope(const string &name, const char *category) : category_(category)
+{
+    if (Tracer::GetInstance().IsEnabled()) {
+        name_ = name;
+        start_ = Tracer::GetInstance().GetTime();
+    }
+}
+
+TraceScope::~TraceScope()
+{
+    if (start_ >= 0) {
+        Tracer::GetInstance().AddSpan(name_, category_, start_, Tracer::GetInstance().GetTime());
+    }
+}
+}
+}
+}
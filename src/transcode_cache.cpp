@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "transcode_cache.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "sys/stat.h"
+#ifdef _WIN32
+#include <sys/utime.h>
+#else
+#include <utime.h>
+#endif
+#include "file_entry.h"
+#include "mapped_file.h"
+#include "resource_util.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+using namespace std;
+namespace {
+constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+constexpr uint32_t ENTRY_VERSION = 1;
+constexpr time_t TEMP_FILE_EXPIRE_SECONDS = 24 * 60 * 60;
+const string META_EXTENSION = ".meta";
+const string DATA_EXTENSION = ".data";
+const string TEMP_EXTENSION = ".tmp";
+
+uint64_t HashBytes(uint64_t hash, const char *data, size_t length)
+{
+    for (size_t i = 0; i < length; i++) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+string ToHex(uint64_t value)
+{
+    static const char DIGITS[] = "0123456789abcdef";
+    string hex(sizeof(value) * 2, '0');
+    for (size_t i = hex.size(); i > 0; i--) {
+        hex[i - 1] = DIGITS[value & 0xf];
+        value >>= 4; // 4 bits per hex digit
+    }
+    return hex;
+}
+
+string GetTempSuffix()
+{
+    // unique between the threads of this build and the builds that share the cache
+    static atomic<uint64_t> count(0);
+    uint64_t now = static_cast<uint64_t>(chrono::steady_clock::now().time_since_epoch().count());
+    uint64_t thread = static_cast<uint64_t>(hash<thread::id>()(this_thread::get_id()));
+    return "." + ToHex(now ^ thread) + ToHex(count++) + TEMP_EXTENSION;
+}
+}
+
+void TranscodeCache::Init(const string &cacheDir, const string &libraryPath)
+{
+    enabled_ = false;
+    if (cacheDir.empty()) {
+        return;
+    }
+    if (!ResourceUtil::CreateDirs(cacheDir)) {
+        cout << "Warning: failed to create the transcode cache '" << cacheDir << "', cache disabled." << endl;
+        return;
+    }
+    if (!GetHash(libraryPath, libraryHash_)) {
+        cout << "Warning: failed to read the transcoder '" << libraryPath << "', cache disabled." << endl;
+        return;
+    }
+    cacheDir_ = cacheDir;
+    enabled_ = true;
+}
+
+bool TranscodeCache::IsEnabled() const
+{
+    return enabled_;
+}
+
+string TranscodeCache::GetKey(const string &src, const string &options, bool extAppend) const
+{
+    if (!enabled_) {
+        return "";
+    }
+    uint64_t contentHash = 0;
+    if (!GetHash(src, contentHash)) {
+        return "";
+    }
+    // the output file name depends on the source file name
+    string config = options;
+    config.append("\n").append(FileEntry::FilePath(src).GetFilename());
+    config.append("\n").append(extAppend ? "1" : "0");
+    uint64_t configHash = HashBytes(libraryHash_, config.c_str(), config.size());
+    return ToHex(contentHash) + ToHex(configHash);
+}
+
+bool TranscodeCache::Get(const string &key, string &outputPath, TranscodeError &error, TranscodeResult &result)
+{
+    Entry entry;
+    if (!ReadEntry(key, entry)) {
+        misses_++;
+        return false;
+    }
+    if (!entry.filename.empty()) {
+        // restored through a temporary file, a failed restore leaves the output as it was and is a miss
+        string output = outputPath + entry.filename;
+        string tempOutput = output + GetTempSuffix();
+        if (!FileEntry::TryCopyFile(GetEntryPath(key, DATA_EXTENSION), tempOutput) ||
+            rename(tempOutput.c_str(), output.c_str()) != 0) {
+            remove(tempOutput.c_str());
+            misses_++;
+            return false;
+        }
+        outputPath = output;
+    }
+    Touch(GetEntryPath(key, META_EXTENSION));
+    error = entry.error;
+    result = entry.result;
+    hits_++;
+    savedTime_ += entry.costTime;
+    return true;
+}
+
+void TranscodeCache::Put(const string &key, const string &outputDir, const string &outputPath,
+    TranscodeError error, const TranscodeResult &result, unsigned long long costTime)
+{
+    if (!enabled_ || key.empty() || !IsCacheable(error)) {
+        return;
+    }
+    Entry entry;
+    entry.error = error;
+    entry.result = result;
+    entry.costTime = costTime;
+    if (error == TranscodeError::SUCCESS) {
+        // only an output in the output directory is restored, the file name is kept with its separator
+        size_t length = outputDir.size();
+        if (outputPath.size() <= length + 1 || outputPath.compare(0, length, outputDir) != 0 ||
+            (outputPath[length] != '/' && outputPath[length] != '\\') ||
+            outputPath.find_first_of("/\\", length + 1) != string::npos) {
+            return;
+        }
+        entry.filename = outputPath.substr(length);
+        string tempData = GetEntryPath(key, DATA_EXTENSION + GetTempSuffix());
+        if (!FileEntry::TryCopyFile(outputPath, tempData)) {
+            remove(tempData.c_str());
+            return;
+        }
+        if (rename(tempData.c_str(), GetEntryPath(key, DATA_EXTENSION).c_str()) != 0) {
+            remove(tempData.c_str());
+            return;
+        }
+    }
+
+    // the meta file is written last, an entry without it is never read
+    ostringstream meta;
+    meta << ENTRY_VERSION << "\n" << static_cast<int32_t>(entry.error) << "\n" << entry.filename << "\n";
+    meta << entry.result.originSize << " " << entry.result.size << " " << entry.result.width << " ";
+    meta << entry.result.height << "\n" << entry.costTime << "\n";
+    string tempMeta = GetEntryPath(key, META_EXTENSION + GetTempSuffix());
+    {
+        ofstream out(tempMeta, ios::out | ios::binary);
+        if (!out.is_open()) {
+            return;
+        }
+        out << meta.str();
+        if (!out.good()) {
+            out.close();
+            remove(tempMeta.c_str());
+            return;
+        }
+    }
+    if (rename(tempMeta.c_str(), GetEntryPath(key, META_EXTENSION).c_str()) != 0) {
+        remove(tempMeta.c_str());
+    }
+}
+
+void TranscodeCache::Trim() const
+{
+    if (!enabled_) {
+        return;
+    }
+    struct CacheFile {
+        time_t lastUsed;
+        uint64_t size;
+        string key;
+    };
+    vector<CacheFile> cacheFiles;
+    uint64_t totalSize = 0;
+    time_t now = time(nullptr);
+    FileEntry dir(cacheDir_);
+    if (!dir.Init()) {
+        return;
+    }
+    for (const auto &child : dir.GetChilds()) {
+        const string &path = child->GetFilePath().GetPath();
+        const string &filename = child->GetFilePath().GetFilename();
+        struct stat s;
+        if (!child->IsFile() || stat(path.c_str(), &s) != 0) {
+            continue;
+        }
+        if (child->GetFilePath().GetExtension() == TEMP_EXTENSION) {
+            // left by an interrupted build
+            if (now - s.st_mtime > TEMP_FILE_EXPIRE_SECONDS) {
+                remove(path.c_str());
+            }
+            continue;
+        }
+        totalSize += static_cast<uint64_t>(s.st_size);
+        if (child->GetFilePath().GetExtension() != META_EXTENSION) {
+            continue;
+        }
+        string key = filename.substr(0, filename.size() - META_EXTENSION.size());
+        struct stat data;
+        uint64_t size = static_cast<uint64_t>(s.st_size);
+        if (stat(GetEntryPath(key, DATA_EXTENSION).c_str(), &data) == 0) {
+            size += static_cast<uint64_t>(data.st_size);
+        }
+        cacheFiles.push_back({ s.st_mtime, size, key });
+    }
+    if (totalSize <= MAX_CACHE_SIZE) {
+        return;
+    }
+
+    sort(cacheFiles.begin(), cacheFiles.end(), [](const auto &a, const auto &b) {
+        return a.lastUsed < b.lastUsed;
+    });
+    for (const auto &cacheFile : cacheFiles) {
+        if (totalSize <= MAX_CACHE_SIZE) {
+            break;
+        }
+        remove(GetEntryPath(cacheFile.key, META_EXTENSION).c_str());
+        remove(GetEntryPath(cacheFile.key, DATA_EXTENSION).c_str());
+        totalSize -= min(totalSize, cacheFile.size);
+    }
+}
+
+string TranscodeCache::GetStatistics() const
+{
+    if (!enabled_) {
+        return "";
+    }
+    string res = "cache:";
+    res.append(to_string(hits_)).append(" hits, ").append(to_string(misses_)).append(" misses, ")
+        .append(to_string(savedTime_)).append(" us saved.");
+    return res;
+}
+
+// below private
+bool TranscodeCache::ReadEntry(const string &key, Entry &entry) const
+{
+    if (!enabled_ || key.empty()) {
+        return false;
+    }
+    ifstream in(GetEntryPath(key, META_EXTENSION), ios::in | ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+    uint32_t version = 0;
+    int32_t error = 0;
+    if (!(in >> version >> error) || version != ENTRY_VERSION) {
+        return false;
+    }
+    in.ignore(1);
+    if (!getline(in, entry.filename)) {
+        return false;
+    }
+    TranscodeResult &result = entry.result;
+    if (!(in >> result.originSize >> result.size >> result.width >> result.height >> entry.costTime)) {
+        return false;
+    }
+    entry.error = static_cast<TranscodeError>(error);
+    return IsCacheable(entry.error) && (entry.error != TranscodeError::SUCCESS || !entry.filename.empty());
+}
+
+string TranscodeCache::GetEntryPath(const string &key, const string &extension) const
+{
+    return FileEntry::FilePath(cacheDir_).Append(key + extension).GetPath();
+}
+
+bool TranscodeCache::GetHash(const string &path, uint64_t &hash)
+{
+    MappedFile file;
+    if (!file.Open(path, false)) {
+        return false;
+    }
+    hash = HashBytes(FNV_OFFSET_BASIS, file.GetData(), file.GetSize());
+    // the size is part of the hash, so that a collision also needs the same size
+    uint64_t size = file.GetSize();
+    hash = HashBytes(hash, reinterpret_cast<const char *>(&size), sizeof(size));
+    return true;
+}
+
+bool TranscodeCache::IsCacheable(TranscodeError error)
+{
+    // a source that does not match the rules is skipped again by the next build, other errors are retried
+    return error == TranscodeError::SUCCESS ||
+        (error >= TranscodeError::NOT_MATCH_BASE && error <= TranscodeError::NOT_MATCH_BUTT);
+}
+
+void TranscodeCache::Touch(const string &path)
+{
+#ifdef _WIN32
+    _utime(path.c_str(), nullptr);
+#else
+    utime(path.c_str(), nullptr);
+#endif
+}
+}
+}
+}
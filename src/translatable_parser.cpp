@@ -15,9 +15,11 @@
 
 #include "translatable_parser.h"
 #include <algorithm>
+#include <cstring>
 #include <iostream>
 #include "restool_errors.h"
 #include "resource_util.h"
+#include "securec.h"
 
 namespace OHOS {
 namespace Global {
@@ -144,7 +146,13 @@ bool TranslatableParse::ReplaceTranslateTags(cJSON *node, const char *key, const
 
     string value = valueNode->valuestring;
     if (GetReplaceStringTranslate(value)) {
-        return cJSON_ReplaceItemInObject(node, key, cJSON_CreateString(value.c_str()));
+        // removing the tags only shortens the value, so it is rewritten in place
+        if (memcpy_s(valueNode->valuestring, strlen(valueNode->valuestring) + 1, value.c_str(),
+            value.length() + 1) != EOK) {
+            PrintError(GetError(ERR_CODE_UNDEFINED_ERROR).FormatCause("memcpy error when replace translate tags")
+                .SetPosition(filePath));
+            return false;
+        }
     }
     return true;
 }
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_RESTOOL_BENCH_ALLOCATION_H
+#define OHOS_RESTOOL_BENCH_ALLOCATION_H
+
+#include <cstddef>
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+/**
+ * @brief get the calls of operator new in this process, the benchmark replaces the global operator new to
+ * count them.
+ * @return the count of allocations.
+ */
+size_t GetAllocationCount();
+}
+}
+}
+#endif
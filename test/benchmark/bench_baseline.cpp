@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bench_baseline.h"
+#include <fstream>
+#include <map>
+#include <regex>
+#include "id_worker.h"
+#include "resource_util.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+using namespace std;
+namespace {
+const map<string, ResType> ID_REFS = {
+    { "^\\$id:", ResType::ID },
+    { "^\\$boolean:", ResType::BOOLEAN },
+    { "^\\$color:", ResType::COLOR },
+    { "^\\$float:", ResType::FLOAT },
+    { "^\\$media:", ResType::MEDIA },
+    { "^\\$profile:", ResType::PROF },
+    { "^\\$integer:", ResType::INTEGER },
+    { "^\\$string:", ResType::STRING },
+    { "^\\$pattern:", ResType::PATTERN },
+    { "^\\$plural:", ResType::PLURAL },
+    { "^\\$theme:", ResType::THEME },
+    { "^\\$symbol:", ResType::SYMBOL }
+};
+
+const map<string, ResType> ID_OHOS_REFS = {
+    { "^\\$ohos:id:", ResType::ID },
+    { "^\\$ohos:boolean:", ResType::BOOLEAN },
+    { "^\\$ohos:color:", ResType::COLOR },
+    { "^\\$ohos:float:", ResType::FLOAT },
+    { "^\\$ohos:media:", ResType::MEDIA },
+    { "^\\$ohos:profile:", ResType::PROF },
+    { "^\\$ohos:integer:", ResType::INTEGER },
+    { "^\\$ohos:string:", ResType::STRING },
+    { "^\\$ohos:pattern:", ResType::PATTERN },
+    { "^\\$ohos:plural:", ResType::PLURAL },
+    { "^\\$ohos:theme:", ResType::THEME },
+    { "^\\$ohos:symbol:", ResType::SYMBOL }
+};
+
+bool ParseRefImpl(string &key, const map<string, ResType> &refs, bool isSystem)
+{
+    // the regexes are built on every call, as the old code did
+    for (const auto &ref : refs) {
+        smatch result;
+        if (regex_search(key, result, regex(ref.first))) {
+            string name = key.substr(result[0].str().length());
+            int64_t id = isSystem ? IdWorker::GetInstance().GetSystemId(ref.second, name) :
+                IdWorker::GetInstance().GetId(ref.second, name);
+            if (id < 0) {
+                return false;
+            }
+            key = to_string(id);
+            if (ref.second != ResType::ID) {
+                key = "$" + ResourceUtil::ResTypeToString(ref.second) + ":" + to_string(id);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+}
+
+bool BenchBaseline::ParseRefString(string &key)
+{
+    if (regex_match(key, regex("^\\$ohos:[a-z]+:.+"))) {
+        return ParseRefImpl(key, ID_OHOS_REFS, true);
+    } else if (regex_match(key, regex("^\\$[a-z]+:.+"))) {
+        return ParseRefImpl(key, ID_REFS, false);
+    }
+    return true;
+}
+
+bool BenchBaseline::CopyFileByStream(const string &src, const string &dst)
+{
+    ifstream in(src, ios::binary);
+    ofstream out(dst, ios::binary);
+    if (!in || !out) {
+        return false;
+    }
+    out << in.rdbuf();
+    return out.good();
+}
+}
+}
+}
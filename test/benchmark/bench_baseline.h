@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_RESTOOL_BENCH_BASELINE_H
+#define OHOS_RESTOOL_BENCH_BASELINE_H
+
+#include <string>
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+/**
+ * The implementations that the optimized code paths replaced, kept here only as the reference of the
+ * benchmarks. They behave like the old code, without its error messages.
+ */
+class BenchBaseline {
+public:
+    /**
+     * @brief resolve a reference like the regex based ReferenceParser::ParseRefString.
+     * @param key: reference such as "$string:app_name", replaced by the reference of the id.
+     * @return true if the key is not a reference or the reference is resolved, other false.
+     */
+    static bool ParseRefString(std::string &key);
+
+    /**
+     * @brief copy a file through iostreams like the old FileEntry::CopyFileInner.
+     * @param src: source file.
+     * @param dst: destination file.
+     * @return true if the file is copied, other false.
+     */
+    static bool CopyFileByStream(const std::string &src, const std::string &dst);
+};
+}
+}
+}
+#endif
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "bench_generator.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include "file_entry.h"
+#include "resource_data.h"
+#include "resource_util.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+using namespace std;
+namespace {
+const vector<string> LANGUAGES = { "zh", "en", "fr", "de", "es", "it", "ja", "ko", "ru", "ar", "pt", "nl" };
+const vector<string> REGIONS = { "CN", "US", "GB", "FR", "DE", "ES", "IT", "JP", "KR", "RU", "BR", "NL" };
+constexpr size_t REF_INTERVAL = 8; // one string of each interval references the string before it
+constexpr size_t HAR_ELEMENT_DIVISOR = 4; // a HAR has a quarter of the entries of the entry module
+constexpr size_t RAWFILES_PER_DIR = 50;
+constexpr size_t FIRST_NUMERIC_REGION = 100;
+constexpr int64_t APP_START_ID = 0x01000000;
+
+// a 1x1 transparent PNG
+const unsigned char PNG_DATA[] = {
+    0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x48, 0x44, 0x52,
+    0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x08, 0x06, 0x00, 0x00, 0x00, 0x1f, 0x15, 0xc4,
+    0x89, 0x00, 0x00, 0x00, 0x0d, 0x49, 0x44, 0x41, 0x54, 0x78, 0x9c, 0x63, 0x00, 0x01, 0x00, 0x00,
+    0x05, 0x00, 0x01, 0x0d, 0x0a, 0x2d, 0xb4, 0x00, 0x00, 0x00, 0x00, 0x49, 0x45, 0x4e, 0x44, 0xae,
+    0x42, 0x60, 0x82
+};
+
+const string CONFIG_CONTENT = R"({
+    "app": {
+        "bundleName": "com.example.bench",
+        "vendor": "example",
+        "version": { "code": 1, "name": "1.0" },
+        "apiVersion": { "compatible": 4, "target": 5 }
+    },
+    "deviceConfig": {},
+    "module": {
+        "package": "com.example.bench",
+        "name": ".Bench",
+        "deviceType": [ "phone" ],
+        "distro": { "deliveryWithInstall": true, "moduleName": "entry", "moduleType": "entry" }
+    }
+}
+)";
+}
+
+BenchGenerator::BenchGenerator(const BenchOptions &options) : options_(options)
+{
+    for (size_t i = 0; i < options_.locales; i++) {
+        locales_.push_back(GetLocale(i));
+    }
+}
+
+bool BenchGenerator::Generate(const string &root)
+{
+    Plan(root);
+    files_.clear();
+    if (ResourceUtil::FileExist(root) && !ResourceUtil::RmoveAllDir(root)) {
+        return false;
+    }
+    const string &entryDir = inputs_[0];
+    if (!WriteFile(FileEntry::FilePath(entryDir).Append(CONFIG_JSON).GetPath(), CONFIG_CONTENT)) {
+        return false;
+    }
+    if (!GenerateModule(entryDir, "", options_.elements, options_.media) || !GenerateRawfiles(entryDir)) {
+        return false;
+    }
+    for (size_t i = 0; i < options_.hars; i++) {
+        string prefix = "har" + to_string(i) + "_";
+        size_t elements = options_.elements / HAR_ELEMENT_DIVISOR;
+        size_t media = options_.media / HAR_ELEMENT_DIVISOR;
+        if (!GenerateModule(inputs_[i + 1], prefix, elements, media)) {
+            return false;
+        }
+    }
+    return GenerateIdDefined();
+}
+
+void BenchGenerator::Plan(const string &root)
+{
+    inputs_.clear();
+    inputs_.push_back(FileEntry::FilePath(root).Append("entry").GetPath());
+    for (size_t i = 0; i < options_.hars; i++) {
+        inputs_.push_back(FileEntry::FilePath(root).Append("har_" + to_string(i)).GetPath());
+    }
+    idDefinedPath_ = FileEntry::FilePath(root).Append(ID_DEFINED_FILE).GetPath();
+}
+
+const vector<string> &BenchGenerator::GetInputs() const
+{
+    return inputs_;
+}
+
+const string &BenchGenerator::GetIdDefinedPath() const
+{
+    return idDefinedPath_;
+}
+
+const vector<string> &BenchGenerator::GetLocales() const
+{
+    return locales_;
+}
+
+const vector<string> &BenchGenerator::GetFiles() const
+{
+    return files_;
+}
+
+// below private
+bool BenchGenerator::GenerateModule(const string &moduleDir, const string &prefix, size_t elements, size_t media)
+{
+    FileEntry::FilePath resourcesDir = FileEntry::FilePath(moduleDir).Append(RESOURCES_DIR);
+    string baseElement = resourcesDir.Append("base").Append("element").GetPath();
+    if (!GenerateElements(baseElement, prefix, elements, "base")) {
+        return false;
+    }
+    for (const auto &locale : locales_) {
+        string localeElement = resourcesDir.Append(locale).Append("element").GetPath();
+        if (!GenerateElements(localeElement, prefix, elements, locale)) {
+            return false;
+        }
+    }
+    string png(reinterpret_cast<const char *>(PNG_DATA), sizeof(PNG_DATA));
+    FileEntry::FilePath mediaDir = resourcesDir.Append("base").Append("media");
+    for (size_t i = 0; i < media; i++) {
+        if (!WriteFile(mediaDir.Append(prefix + "media_" + to_string(i) + ".png").GetPath(), png)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BenchGenerator::GenerateElements(const string &elementDir, const string &prefix, size_t elements,
+    const string &value)
+{
+    string strings = "{\n    \"string\": [\n";
+    string integers = "{\n    \"integer\": [\n";
+    for (size_t i = 0; i < elements; i++) {
+        string separator = i + 1 < elements ? ",\n" : "\n";
+        string name = prefix + "string_" + to_string(i);
+        string stringValue = value + " " + name;
+        if (i > 0 && i % REF_INTERVAL == 0) {
+            stringValue = "$string:" + prefix + "string_" + to_string(i - 1);
+        }
+        strings.append("        { \"name\": \"").append(name).append("\", \"value\": \"").append(stringValue)
+            .append("\" }").append(separator);
+        integers.append("        { \"name\": \"").append(prefix).append("integer_").append(to_string(i))
+            .append("\", \"value\": ").append(to_string(i)).append(" }").append(separator);
+    }
+    strings.append("    ]\n}\n");
+    integers.append("    ]\n}\n");
+    return WriteFile(FileEntry::FilePath(elementDir).Append("string.json").GetPath(), strings) &&
+        WriteFile(FileEntry::FilePath(elementDir).Append("integer.json").GetPath(), integers);
+}
+
+bool BenchGenerator::GenerateRawfiles(const string &moduleDir)
+{
+    FileEntry::FilePath rawfileDir = FileEntry::FilePath(moduleDir).Append(RESOURCES_DIR).Append(RAW_FILE_DIR);
+    string content;
+    content.reserve(options_.rawfileSize);
+    for (size_t i = 0; i < options_.rawfileSize; i++) {
+        content.push_back(static_cast<char>('a' + i % 26)); // 26 letters
+    }
+    for (size_t i = 0; i < options_.rawfiles; i++) {
+        string subDir = "dir_" + to_string(i / RAWFILES_PER_DIR);
+        if (!WriteFile(rawfileDir.Append(subDir).Append("raw_" + to_string(i) + ".bin").GetPath(), content)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BenchGenerator::GenerateIdDefined()
+{
+    string content = "{\n    \"record\": [\n";
+    for (size_t i = 0; i < options_.idDefined; i++) {
+        // the first ids are taken by generated strings, the others are only reserved
+        string name = i < options_.elements ? "string_" + to_string(i) : "defined_" + to_string(i);
+        char id[16]; // 0x and 8 hex digits
+        snprintf(id, sizeof(id), "0x%08llx", static_cast<unsigned long long>(APP_START_ID + i));
+        content.append("        { \"type\": \"string\", \"name\": \"").append(name).append("\", \"id\": \"")
+            .append(id).append("\" }").append(i + 1 < options_.idDefined ? ",\n" : "\n");
+    }
+    content.append("    ]\n}\n");
+    return WriteFile(idDefinedPath_, content);
+}
+
+bool BenchGenerator::WriteFile(const string &path, const string &content)
+{
+    string parent = FileEntry::FilePath(path).GetParent().GetPath();
+    if (!ResourceUtil::CreateDirs(parent)) {
+        return false;
+    }
+    ofstream out(path, ofstream::out | ofstream::binary);
+    if (!out.is_open()) {
+        cerr << "Error: failed to create '" << path << "'." << endl;
+        return false;
+    }
+    out.write(content.c_str(), content.size());
+    if (!out.good()) {
+        cerr << "Error: failed to write '" << path << "'." << endl;
+        return false;
+    }
+    files_.push_back(path);
+    return true;
+}
+
+string BenchGenerator::GetLocale(size_t index)
+{
+    size_t named = LANGUAGES.size() * REGIONS.size();
+    if (index < named) {
+        string region = REGIONS[(index / LANGUAGES.size() + index) % REGIONS.size()];
+        return LANGUAGES[index % LANGUAGES.size()] + "_" + region;
+    }
+    // a region can also be a 3 digit code
+    size_t numeric = index - named;
+    return LANGUAGES[numeric % LANGUAGES.size()] + "_" + to_string(FIRST_NUMERIC_REGION + numeric / LANGUAGES.size());
+}
+}
+}
+}
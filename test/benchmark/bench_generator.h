@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_RESTOOL_BENCH_GENERATOR_H
+#define OHOS_RESTOOL_BENCH_GENERATOR_H
+
+#include <string>
+#include <vector>
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+struct BenchOptions {
+    size_t locales = 8;
+    size_t elements = 1000; // string and integer entries of each element file
+    size_t media = 200;
+    size_t rawfiles = 200;
+    size_t rawfileSize = 4096;
+    size_t hars = 4;
+    size_t idDefined = 500;
+};
+
+/**
+ * Generates a synthetic resource tree: an entry module and the HAR modules it depends on, each with the
+ * base and locale element files and media, the rawfiles of the entry module and an id_defined.json.
+ * The content only depends on the options, so two runs with the same options compile the same tree.
+ */
+class BenchGenerator {
+public:
+    explicit BenchGenerator(const BenchOptions &options);
+
+    /**
+     * @brief generate the resource tree, the directory is removed first.
+     * @param root: directory of the tree.
+     * @return true if the tree is generated, other false.
+     */
+    bool Generate(const std::string &root);
+
+    /**
+     * @brief set the inputs and the id_defined.json of a tree generated before, nothing is written.
+     * @param root: directory of the tree.
+     */
+    void Plan(const std::string &root);
+
+    const std::vector<std::string> &GetInputs() const;
+    const std::string &GetIdDefinedPath() const;
+    const std::vector<std::string> &GetLocales() const;
+    const std::vector<std::string> &GetFiles() const;
+
+    /**
+     * @brief get the locale qualifier of an index, such as "zh_CN".
+     * @param index: index of the locale, less than MAX_LOCALES.
+     * @return the locale, different for every index.
+     */
+    static std::string GetLocale(size_t index);
+    static constexpr size_t MAX_LOCALES = 10944; // 12 languages, 12 named and 900 numeric regions
+
+private:
+    bool GenerateModule(const std::string &moduleDir, const std::string &prefix, size_t elements, size_t media);
+    bool GenerateElements(const std::string &elementDir, const std::string &prefix, size_t elements,
+        const std::string &value);
+    bool GenerateRawfiles(const std::string &moduleDir);
+    bool GenerateIdDefined();
+    bool WriteFile(const std::string &path, const std::string &content);
+
+    BenchOptions options_;
+    std::vector<std::string> inputs_;
+    std::string idDefinedPath_;
+    std::vector<std::string> locales_;
+    std::vector<std::string> files_;
+};
+}
+}
+}
+#endif
@@ -0,0 +1,848 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#include "bench_allocation.h"
+#include "bench_baseline.h"
+#include "bench_generator.h"
+#include "cmd/cmd_parser.h"
+#include "file_entry.h"
+#include "id_worker.h"
+#include "json_document.h"
+#include "key_parser.h"
+#include "reference_parser.h"
+#include "resource_data.h"
+#include "resource_item.h"
+#include "resource_module.h"
+#include "resource_table.h"
+#include "resource_util.h"
+#include "restool_errors.h"
+
+using namespace std;
+using namespace OHOS::Global::Restool;
+
+namespace {
+constexpr size_t WARMUP_DIVISOR = 10;
+constexpr size_t TABLE_DIVISOR = 1000; // loading or saving the whole table is far slower than the other cases
+constexpr size_t SMALL_COPY_SIZE = 4 * 1024;
+constexpr size_t LARGE_COPY_SIZE = 4 * 1024 * 1024;
+constexpr size_t REF_KINDS = 4; // string, integer and media references and plain text
+constexpr size_t REF_CHECK_COUNT = 1000; // references checked against the baseline before timing
+constexpr size_t MISS_LOCALES = 144;
+constexpr double NS_PER_MS = 1000000.0;
+const string PACKAGE_NAME = "com.example.bench";
+const vector<string> QUALIFIERS = {
+    "base", "phone", "dark", "ldpi", "xxxhdpi", "vertical-phone-dark-mdpi", "mcc460_mnc101-zh_Hans_CN-tablet",
+    "en_GB-horizontal-car-light-xldpi", "invalid_qualifier"
+};
+// the qualifiers after the locale, in the order of the folder name, an empty value is left out
+const vector<vector<string>> QUALIFIER_VALUES = {
+    { "", "vertical", "horizontal" },
+    { "", "phone", "tablet", "car", "tv", "wearable", "2in1" },
+    { "", "dark", "light" },
+    { "", "sdpi", "mdpi", "ldpi", "xldpi", "xxldpi", "xxxldpi" },
+};
+const vector<string> IGNORED_NAMES = { ".git", ".svn", "Thumbs.db", "picasa.ini", "scheme~", ".DS_Store" };
+
+volatile size_t g_sink = 0; // keeps the measured calls from being optimized away
+
+struct BenchResult {
+    string name;
+    size_t iterations;
+    size_t repeat;
+    double nsPerOp;
+    double minNsPerOp;
+    map<string, double> metrics;
+};
+
+class RestoolBench {
+public:
+    uint32_t Parse(int argc, char *argv[]);
+    uint32_t Run();
+
+private:
+    uint32_t ParseNumber(const string &option, const string &value, size_t &number) const;
+    uint32_t ParseScaling();
+    bool IsSelected(const string &name) const;
+    BenchResult *Measure(const string &name, size_t iterations, const function<void(size_t)> &f);
+    BenchResult *AddResult(const string &name, size_t iterations, vector<double> samples);
+    uint32_t Generate();
+    uint32_t Pack(const string &output);
+    void BenchKeyParser();
+    void BenchIgnoreFile();
+    void BenchReference();
+    void BenchIdWorker();
+    void BenchJson();
+    void BenchCopy();
+    void BenchCopy(const string &name, size_t count, size_t size);
+    void BenchResourceTable();
+    void BenchScaling();
+    void BenchTranscodeCache();
+    vector<string> GetChildArgs(size_t threadCount, bool transcode) const;
+    bool RunChild(const vector<string> &args, double &costNs, double &peakRssKb) const;
+    static bool LoadChildResult(const string &path, double &costNs, double &peakRssKb);
+    static double GetPeakRssKb();
+    uint32_t SaveResults() const;
+    static void ShowUsage();
+
+    BenchOptions options_;
+    BenchGenerator *generator_ = nullptr;
+    string restoolPath_;
+    string workDir_ = "restool_bench_work";
+    string resultPath_ = "restool_bench.json";
+    string filter_;
+    string scaling_ = "1,2,4,8";
+    string compression_;
+    size_t iterations_ = 10000;
+    size_t repeat_ = 5;
+    size_t threadCount_ = 0;
+    size_t refStrings_ = 500000;
+    size_t copySmall_ = 10000;
+    size_t copyLarge_ = 16;
+    bool packOnly_ = false;
+    vector<size_t> threadCounts_;
+    size_t packAllocations_ = 0;
+    vector<BenchResult> results_;
+};
+
+uint32_t RestoolBench::Parse(int argc, char *argv[])
+{
+    restoolPath_ = argv[0];
+    map<string, size_t *> numbers = {
+        { "--locales", &options_.locales }, { "--elements", &options_.elements }, { "--media", &options_.media },
+        { "--rawfiles", &options_.rawfiles }, { "--rawfile-size", &options_.rawfileSize },
+        { "--hars", &options_.hars }, { "--ids", &options_.idDefined }, { "--iterations", &iterations_ },
+        { "--repeat", &repeat_ }, { "--thread", &threadCount_ }, { "--ref-strings", &refStrings_ },
+        { "--copy-small", &copySmall_ }, { "--copy-large", &copyLarge_ }
+    };
+    map<string, string *> strings = {
+        { "--work", &workDir_ }, { "--output", &resultPath_ }, { "--filter", &filter_ },
+        { "--scaling", &scaling_ }, { "--compression", &compression_ }
+    };
+    for (int i = 1; i < argc; i++) {
+        string option = argv[i];
+        if (option == "-h" || option == "--help") {
+            ShowUsage();
+            exit(0);
+        }
+        if (option == "--pack-only") {
+            packOnly_ = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            cerr << "Error: missing value of '" << option << "'." << endl;
+            return RESTOOL_ERROR;
+        }
+        string value = argv[++i];
+        if (numbers.count(option) != 0) {
+            if (ParseNumber(option, value, *numbers[option]) != RESTOOL_SUCCESS) {
+                return RESTOOL_ERROR;
+            }
+        } else if (strings.count(option) != 0) {
+            *strings[option] = value;
+        } else {
+            cerr << "Error: unknown option '" << option << "'." << endl;
+            ShowUsage();
+            return RESTOOL_ERROR;
+        }
+    }
+    if (iterations_ == 0 || repeat_ == 0) {
+        cerr << "Error: --iterations and --repeat must be greater than 0." << endl;
+        return RESTOOL_ERROR;
+    }
+    if (options_.locales > BenchGenerator::MAX_LOCALES) {
+        cerr << "Error: --locales must not be greater than " << BenchGenerator::MAX_LOCALES << "." << endl;
+        return RESTOOL_ERROR;
+    }
+    return ParseScaling();
+}
+
+uint32_t RestoolBench::Run()
+{
+    BenchGenerator generator(options_);
+    generator_ = &generator;
+    string input = FileEntry::FilePath(workDir_).Append("input").GetPath();
+    if (packOnly_) {
+        // a child process of BenchScaling or BenchTranscodeCache, the tree is generated by the parent
+        generator.Plan(input);
+        if (Pack(FileEntry::FilePath(workDir_).Append("child_output").GetPath()) != RESTOOL_SUCCESS) {
+            return RESTOOL_ERROR;
+        }
+        return SaveResults();
+    }
+    if (Generate() != RESTOOL_SUCCESS || Pack(FileEntry::FilePath(workDir_).Append("output").GetPath()) !=
+        RESTOOL_SUCCESS) {
+        return RESTOOL_ERROR;
+    }
+    // the microbenchmarks use the ids and the resources.index of the pack
+    BenchKeyParser();
+    BenchIgnoreFile();
+    BenchReference();
+    BenchIdWorker();
+    BenchJson();
+    BenchCopy();
+    BenchResourceTable();
+    BenchScaling();
+    BenchTranscodeCache();
+    generator_ = nullptr;
+    return SaveResults();
+}
+
+uint32_t RestoolBench::ParseNumber(const string &option, const string &value, size_t &number) const
+{
+    char *end = nullptr;
+    unsigned long long result = strtoull(value.c_str(), &end, 10); // decimal
+    if (value.empty() || value[0] == '-' || end == nullptr || *end != '\0') {
+        cerr << "Error: invalid value '" << value << "' of '" << option << "'." << endl;
+        return RESTOOL_ERROR;
+    }
+    number = static_cast<size_t>(result);
+    return RESTOOL_SUCCESS;
+}
+
+uint32_t RestoolBench::ParseScaling()
+{
+    threadCounts_.clear();
+    if (scaling_.empty()) {
+        return RESTOOL_SUCCESS;
+    }
+    vector<string> values;
+    ResourceUtil::Split(scaling_, values, ",");
+    for (const auto &value : values) {
+        size_t threadCount = 0;
+        if (ParseNumber("--scaling", value, threadCount) != RESTOOL_SUCCESS) {
+            return RESTOOL_ERROR;
+        }
+        if (threadCount == 0) {
+            cerr << "Error: thread counts of --scaling must be greater than 0." << endl;
+            return RESTOOL_ERROR;
+        }
+        threadCounts_.push_back(threadCount);
+    }
+    return RESTOOL_SUCCESS;
+}
+
+bool RestoolBench::IsSelected(const string &name) const
+{
+    return filter_.empty() || name.find(filter_) != string::npos;
+}
+
+BenchResult *RestoolBench::Measure(const string &name, size_t iterations, const function<void(size_t)> &f)
+{
+    if (!IsSelected(name) || iterations == 0) {
+        return nullptr;
+    }
+    for (size_t i = 0; i < iterations / WARMUP_DIVISOR; i++) {
+        f(i);
+    }
+    vector<double> samples;
+    size_t allocations = GetAllocationCount();
+    for (size_t r = 0; r < repeat_; r++) {
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < iterations; i++) {
+            f(i);
+        }
+        chrono::duration<double, nano> cost = chrono::steady_clock::now() - start;
+        samples.push_back(cost.count() / iterations);
+    }
+    allocations = GetAllocationCount() - allocations;
+    BenchResult *result = AddResult(name, iterations, move(samples));
+    result->metrics["allocsPerOp"] = static_cast<double>(allocations) / (iterations * repeat_);
+    return result;
+}
+
+BenchResult *RestoolBench::AddResult(const string &name, size_t iterations, vector<double> samples)
+{
+    sort(samples.begin(), samples.end());
+    results_.push_back({ name, iterations, samples.size(), samples[samples.size() / 2], samples[0], {} });
+    cout << "Info: bench " << name << ": " << results_.back().nsPerOp << " ns/op (min " <<
+        results_.back().minNsPerOp << ")" << endl;
+    // valid until the next result is added
+    return &results_.back();
+}
+
+uint32_t RestoolBench::Generate()
+{
+    auto start = chrono::steady_clock::now();
+    if (!generator_->Generate(FileEntry::FilePath(workDir_).Append("input").GetPath())) {
+        cerr << "Error: failed to generate the resources in '" << workDir_ << "'." << endl;
+        return RESTOOL_ERROR;
+    }
+    chrono::duration<double, nano> cost = chrono::steady_clock::now() - start;
+    results_.push_back({ "generate", 1, 1, cost.count(), cost.count(), {} });
+    cout << "Info: generated " << generator_->GetFiles().size() << " files." << endl;
+    return RESTOOL_SUCCESS;
+}
+
+uint32_t RestoolBench::Pack(const string &output)
+{
+    // the output path must exist
+    if (!ResourceUtil::CreateDirs(output)) {
+        return RESTOOL_ERROR;
+    }
+    vector<string> args = { restoolPath_ };
+    for (const auto &input : generator_->GetInputs()) {
+        args.insert(args.end(), { "-i", input });
+    }
+    // the entry module is the first input, its config.json is required with more than one input
+    string configPath = FileEntry::FilePath(generator_->GetInputs().front()).Append(CONFIG_JSON).GetPath();
+    args.insert(args.end(), { "-j", configPath, "-o", output, "-p", PACKAGE_NAME, "-f" });
+    args.insert(args.end(), { "-r", FileEntry::FilePath(output).Append("ResourceTable.h").GetPath() });
+    args.insert(args.end(), { "--defined-ids", generator_->GetIdDefinedPath() });
+    if (threadCount_ > 0) {
+        args.insert(args.end(), { "--thread", to_string(threadCount_) });
+    }
+    if (packOnly_ && !compression_.empty()) {
+        string cacheDir = FileEntry::FilePath(workDir_).Append("transcode_cache").GetPath();
+        args.insert(args.end(), { "--compressed-config", compression_, "--transcode-cache", cacheDir });
+    }
+    vector<char *> argv;
+    for (auto &arg : args) {
+        argv.push_back(&arg[0]);
+    }
+    argv.push_back(nullptr);
+
+    // the singletons keep the state of the pack, so a process packs only once
+    size_t allocations = GetAllocationCount();
+    auto start = chrono::steady_clock::now();
+    if (CmdParser::GetInstance().Parse(static_cast<int>(args.size()), argv.data(), 1) != RESTOOL_SUCCESS) {
+        cerr << "Error: failed to pack the generated resources." << endl;
+        return RESTOOL_ERROR;
+    }
+    chrono::duration<double, nano> cost = chrono::steady_clock::now() - start;
+    packAllocations_ = GetAllocationCount() - allocations;
+    results_.push_back({ "pack", 1, 1, cost.count(), cost.count(), {} });
+    results_.back().metrics["allocations"] = static_cast<double>(packAllocations_);
+    results_.back().metrics["peakRssKb"] = GetPeakRssKb();
+    return RESTOOL_SUCCESS;
+}
+
+void RestoolBench::BenchKeyParser()
+{
+    // a folder name is parsed once and then taken from the cache, so every name of the miss pass is new
+    vector<string> folderNames;
+    for (size_t i = 0; i < MISS_LOCALES; i++) {
+        vector<string> names = { BenchGenerator::GetLocale(i) };
+        for (const auto &values : QUALIFIER_VALUES) {
+            vector<string> next;
+            for (const auto &name : names) {
+                for (const auto &value : values) {
+                    next.push_back(value.empty() ? name : name + "-" + value);
+                }
+            }
+            names.swap(next);
+        }
+        // the first name is the bare locale, it may be parsed by the pack
+        folderNames.insert(folderNames.end(), names.begin() + 1, names.end());
+    }
+    size_t missIterations = min(iterations_, folderNames.size() * WARMUP_DIVISOR / (repeat_ * WARMUP_DIVISOR + 1));
+    size_t next = 0;
+    BenchResult *result = Measure("KeyParser::Parse miss", missIterations, [&folderNames, &next](size_t) {
+        auto keyParams = KeyParser::Parse(folderNames[next++]);
+        g_sink += keyParams != nullptr ? keyParams->size() : 0;
+    });
+    if (result != nullptr) {
+        result->metrics["folderNames"] = static_cast<double>(next);
+    }
+
+    folderNames.insert(folderNames.end(), generator_->GetLocales().begin(), generator_->GetLocales().end());
+    folderNames.insert(folderNames.end(), QUALIFIERS.begin(), QUALIFIERS.end());
+    for (const auto &folderName : folderNames) {
+        KeyParser::Parse(folderName);
+    }
+    result = Measure("KeyParser::Parse hit", iterations_, [&folderNames](size_t i) {
+        auto keyParams = KeyParser::Parse(folderNames[i % folderNames.size()]);
+        g_sink += keyParams != nullptr ? keyParams->size() : 0;
+    });
+    if (result != nullptr) {
+        result->metrics["folderNames"] = static_cast<double>(folderNames.size());
+    }
+}
+
+void RestoolBench::BenchIgnoreFile()
+{
+    vector<unique_ptr<FileEntry>> entries;
+    for (const auto &file : generator_->GetFiles()) {
+        entries.push_back(make_unique<FileEntry>(file));
+    }
+    for (const auto &name : IGNORED_NAMES) {
+        entries.push_back(make_unique<FileEntry>(FileEntry::FilePath(workDir_).Append(name).GetPath()));
+    }
+    Measure("ResourceUtil::IsIgnoreFile", iterations_, [&entries](size_t i) {
+        g_sink += ResourceUtil::IsIgnoreFile(*entries[i % entries.size()]) ? 1 : 0;
+    });
+}
+
+void RestoolBench::BenchReference()
+{
+    if (!IsSelected("reference")) {
+        return;
+    }
+    // references to the resources of the entry module mixed with plain text, all of them resolve
+    vector<string> refs;
+    refs.reserve(refStrings_);
+    for (size_t i = 0; i < refStrings_; i++) {
+        size_t index = i / REF_KINDS;
+        // 0: string, 1: integer, 2: media, 3: plain text
+        switch (options_.elements > 0 ? i % REF_KINDS : REF_KINDS - 1) {
+            case 0:
+                refs.push_back("$string:string_" + to_string(index % options_.elements));
+                break;
+            case 1:
+                refs.push_back("$integer:integer_" + to_string(index % options_.elements));
+                break;
+            case 2:
+                refs.push_back(options_.media > 0 ? "$media:media_" + to_string(index % options_.media) :
+                    "$string:string_" + to_string(index % options_.elements));
+                break;
+            default:
+                refs.push_back("plain text " + to_string(i));
+                break;
+        }
+    }
+    ReferenceParser referenceParser;
+    for (size_t i = 0; i < min(refs.size(), REF_CHECK_COUNT); i++) {
+        string value = refs[i];
+        string baseline = refs[i];
+        bool update = false;
+        if (referenceParser.ParseRefInString(value, update) != RESTOOL_SUCCESS ||
+            !BenchBaseline::ParseRefString(baseline) || value != baseline) {
+            cerr << "Error: reference '" << refs[i] << "' is resolved to '" << value << "', the baseline to '" <<
+                baseline << "'." << endl;
+            return;
+        }
+    }
+    Measure("reference ReferenceParser::ParseRefInString", refs.size(), [&refs, &referenceParser](size_t i) {
+        string value = refs[i];
+        bool update = false;
+        g_sink += referenceParser.ParseRefInString(value, update) == RESTOOL_SUCCESS ? value.size() : 0;
+    });
+    Measure("reference baseline regex", refs.size(), [&refs](size_t i) {
+        string value = refs[i];
+        g_sink += BenchBaseline::ParseRefString(value) ? value.size() : 0;
+    });
+}
+
+void RestoolBench::BenchIdWorker()
+{
+    // every call takes a new name, a name that already has an id is only a lookup
+    size_t count = iterations_ / WARMUP_DIVISOR + iterations_ * repeat_;
+    vector<string> names;
+    names.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        names.push_back("bench_" + to_string(i));
+    }
+    size_t next = 0;
+    Measure("IdWorker::GenerateId", iterations_, [&names, &next](size_t) {
+        g_sink += static_cast<size_t>(IdWorker::GetInstance().GenerateId(ResType::STRING, names[next++]));
+    });
+}
+
+void RestoolBench::BenchJson()
+{
+    vector<string> files;
+    double bytes = 0;
+    for (const auto &file : generator_->GetFiles()) {
+        if (FileEntry::FilePath(file).GetParent().GetFilename() == "element") {
+            ifstream in(file, ios::binary | ios::ate);
+            bytes += static_cast<double>(in.tellg());
+            files.push_back(file);
+        }
+    }
+    if (files.empty()) {
+        return;
+    }
+    double bytesPerOp = bytes / files.size();
+    BenchResult *result = Measure("json JsonDocument::Load", files.size(), [&files](size_t i) {
+        JsonDocument document;
+        g_sink += document.Load(files[i]) ? 1 : 0;
+    });
+    if (result != nullptr) {
+        result->metrics["MBps"] = bytesPerOp / result->nsPerOp * 1000; // bytes per ns to MB per second
+    }
+    result = Measure("json baseline cJSON", files.size(), [&files](size_t i) {
+        cJSON *root = nullptr;
+        g_sink += ResourceUtil::OpenJsonFile(files[i], &root) ? 1 : 0;
+        cJSON_Delete(root);
+    });
+    if (result != nullptr) {
+        result->metrics["MBps"] = bytesPerOp / result->nsPerOp * 1000; // bytes per ns to MB per second
+    }
+}
+
+void RestoolBench::BenchCopy()
+{
+    BenchCopy("4KiB", copySmall_, SMALL_COPY_SIZE);
+    BenchCopy("4MiB", copyLarge_, LARGE_COPY_SIZE);
+}
+
+void RestoolBench::BenchCopy(const string &name, size_t count, size_t size)
+{
+    string copyName = "copy " + name;
+    if (count == 0 || !IsSelected(copyName)) {
+        return;
+    }
+    FileEntry::FilePath copyDir = FileEntry::FilePath(workDir_).Append("copy");
+    if (!ResourceUtil::CreateDirs(copyDir.GetPath())) {
+        return;
+    }
+    string content(size, '\0');
+    for (size_t i = 0; i < size; i++) {
+        content[i] = static_cast<char>('a' + i % 26); // 26 letters
+    }
+    vector<string> sources;
+    vector<string> targets;
+    for (size_t i = 0; i < count; i++) {
+        sources.push_back(copyDir.Append(name + "_" + to_string(i) + ".bin").GetPath());
+        targets.push_back(copyDir.Append(name + "_" + to_string(i) + ".out").GetPath());
+        ofstream out(sources.back(), ofstream::out | ofstream::binary);
+        out.write(content.c_str(), content.size());
+        if (!out.good()) {
+            cerr << "Error: failed to write '" << sources.back() << "'." << endl;
+            return;
+        }
+    }
+    BenchResult *result = Measure(copyName + " FileEntry::CopyFileInner", count, [&sources, &targets](size_t i) {
+        g_sink += FileEntry::CopyFileInner(sources[i], targets[i]) ? 1 : 0;
+    });
+    if (result != nullptr) {
+        result->metrics["MBps"] = size / result->nsPerOp * 1000; // bytes per ns to MB per second
+    }
+    result = Measure(copyName + " baseline iostream", count, [&sources, &targets](size_t i) {
+        g_sink += BenchBaseline::CopyFileByStream(sources[i], targets[i]) ? 1 : 0;
+    });
+    if (result != nullptr) {
+        result->metrics["MBps"] = size / result->nsPerOp * 1000; // bytes per ns to MB per second
+    }
+}
+
+void RestoolBench::BenchResourceTable()
+{
+    string indexPath = FileEntry::FilePath(workDir_).Append("output").Append(RESOURCE_INDEX_FILE).GetPath();
+    map<int64_t, vector<ResourceItem>> resInfos;
+    if (ResourceTable::LoadResTable(indexPath, resInfos) != RESTOOL_SUCCESS) {
+        cerr << "Error: failed to load '" << indexPath << "'." << endl;
+        return;
+    }
+    size_t resources = 0;
+    for (const auto &resInfo : resInfos) {
+        resources += resInfo.second.size();
+    }
+    for (auto &result : results_) {
+        if (result.name == "pack" && resources > 0) {
+            result.metrics["resources"] = static_cast<double>(resources);
+            result.metrics["allocationsPerResource"] = static_cast<double>(packAllocations_) / resources;
+        }
+    }
+    size_t tableIterations = max<size_t>(1, iterations_ / TABLE_DIVISOR);
+    Measure("ResourceTable::LoadResTable", tableIterations, [&indexPath](size_t) {
+        map<int64_t, vector<ResourceItem>> loaded;
+        ResourceTable::LoadResTable(indexPath, loaded);
+        g_sink += loaded.size();
+    });
+    Measure("ResourceModule::MergeResourceItem", tableIterations, [&resInfos](size_t) {
+        map<int64_t, vector<ResourceItem>> merged;
+        ResourceModule::MergeResourceItem(merged, resInfos);
+        g_sink += merged.size();
+    });
+
+    vector<ResourceItem> items;
+    map<int64_t, vector<shared_ptr<ResourceItem>>> sharedItems;
+    for (const auto &resInfo : resInfos) {
+        for (const auto &item : resInfo.second) {
+            items.push_back(item);
+            sharedItems[resInfo.first].push_back(make_shared<ResourceItem>(item));
+        }
+    }
+    Measure("ResourceTable::CreateResourceTable", tableIterations, [&sharedItems](size_t) {
+        ResourceTable resourceTable;
+        g_sink += resourceTable.CreateResourceTable(sharedItems);
+    });
+    if (items.empty()) {
+        return;
+    }
+    Measure("ResourceItem copy", iterations_, [&items](size_t i) {
+        ResourceItem copy = items[i % items.size()];
+        g_sink += copy.GetDataLength();
+    });
+}
+
+void RestoolBench::BenchScaling()
+{
+    // a process packs only once, so every pack runs in a child process
+#ifdef _WIN32
+    cout << "Info: bench pack --thread skipped, child processes are not supported on Windows." << endl;
+    return;
+#endif
+    double baseNs = 0;
+    for (size_t threadCount : threadCounts_) {
+        string name = "pack --thread " + to_string(threadCount);
+        if (!IsSelected(name)) {
+            continue;
+        }
+        vector<double> samples;
+        double peakRssKb = 0;
+        for (size_t r = 0; r < repeat_; r++) {
+            double costNs = 0;
+            double rssKb = 0;
+            if (!RunChild(GetChildArgs(threadCount, false), costNs, rssKb)) {
+                cerr << "Error: failed to run '" << name << "'." << endl;
+                return;
+            }
+            samples.push_back(costNs);
+            peakRssKb = max(peakRssKb, rssKb);
+        }
+        BenchResult *result = AddResult(name, 1, move(samples));
+        if (baseNs == 0) {
+            baseNs = result->nsPerOp;
+        }
+        result->metrics["threads"] = static_cast<double>(threadCount);
+        result->metrics["speedup"] = baseNs / result->nsPerOp;
+        result->metrics["peakRssKb"] = peakRssKb;
+    }
+}
+
+void RestoolBench::BenchTranscodeCache()
+{
+    if (!IsSelected("transcode cache")) {
+        return;
+    }
+    if (compression_.empty()) {
+        cout << "Info: bench transcode cache skipped, it needs the --compression config of a transcoder." << endl;
+        return;
+    }
+#ifdef _WIN32
+    cout << "Info: bench transcode cache skipped, child processes are not supported on Windows." << endl;
+    return;
+#endif
+    // a cold pack starts from an empty cache, the warm pack after it restores every image from the cache
+    string cacheDir = FileEntry::FilePath(workDir_).Append("transcode_cache").GetPath();
+    vector<double> coldSamples;
+    vector<double> warmSamples;
+    for (size_t r = 0; r < repeat_; r++) {
+        if (ResourceUtil::FileExist(cacheDir) && !ResourceUtil::RmoveAllDir(cacheDir)) {
+            return;
+        }
+        double coldNs = 0;
+        double warmNs = 0;
+        double rssKb = 0;
+        if (!RunChild(GetChildArgs(threadCount_, true), coldNs, rssKb) ||
+            !RunChild(GetChildArgs(threadCount_, true), warmNs, rssKb)) {
+            cerr << "Error: failed to pack with the transcode cache." << endl;
+            return;
+        }
+        coldSamples.push_back(coldNs);
+        warmSamples.push_back(warmNs);
+    }
+    AddResult("transcode cache cold", 1, move(coldSamples));
+    double coldNs = results_.back().nsPerOp;
+    BenchResult *result = AddResult("transcode cache warm", 1, move(warmSamples));
+    result->metrics["savedMs"] = (coldNs - result->nsPerOp) / NS_PER_MS;
+}
+
+vector<string> RestoolBench::GetChildArgs(size_t threadCount, bool transcode) const
+{
+    vector<string> args = { restoolPath_, "--pack-only", "--work", workDir_, "--hars", to_string(options_.hars),
+        "--output", FileEntry::FilePath(workDir_).Append("child_result.json").GetPath() };
+    if (threadCount > 0) {
+        args.insert(args.end(), { "--thread", to_string(threadCount) });
+    }
+    if (transcode) {
+        args.insert(args.end(), { "--compression", compression_ });
+    }
+    return args;
+}
+
+bool RestoolBench::RunChild(const vector<string> &args, double &costNs, double &peakRssKb) const
+{
+#ifdef _WIN32
+    cerr << "Error: child processes are not supported on Windows." << endl;
+    return false;
+#else
+    // the child reports the time and the memory of its pack, without the start of the process
+    string resultPath = FileEntry::FilePath(workDir_).Append("child_result.json").GetPath();
+    remove(resultPath.c_str());
+    vector<char *> argv;
+    for (const auto &arg : args) {
+        argv.push_back(const_cast<char *>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+    pid_t pid = fork();
+    if (pid < 0) {
+        return false;
+    }
+    if (pid == 0) {
+        // only the errors of the child are shown
+        int null = open("/dev/null", O_WRONLY);
+        if (null >= 0) {
+            dup2(null, STDOUT_FILENO);
+            close(null);
+        }
+        execvp(argv[0], argv.data());
+        _exit(127); // 127: the command can not be run
+    }
+    int status = 0;
+    if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        return false;
+    }
+    return LoadChildResult(resultPath, costNs, peakRssKb);
+#endif
+}
+
+bool RestoolBench::LoadChildResult(const string &path, double &costNs, double &peakRssKb)
+{
+    cJSON *root = nullptr;
+    if (!ResourceUtil::OpenJsonFile(path, &root)) {
+        return false;
+    }
+    bool found = false;
+    cJSON *results = cJSON_GetObjectItem(root, "results");
+    for (cJSON *item = cJSON_IsArray(results) ? results->child : nullptr; item; item = item->next) {
+        cJSON *name = cJSON_GetObjectItem(item, "name");
+        cJSON *nsPerOp = cJSON_GetObjectItem(item, "nsPerOp");
+        cJSON *rss = cJSON_GetObjectItem(item, "peakRssKb");
+        if (cJSON_IsString(name) && string(name->valuestring) == "pack" && cJSON_IsNumber(nsPerOp) &&
+            cJSON_IsNumber(rss)) {
+            costNs = nsPerOp->valuedouble;
+            peakRssKb = rss->valuedouble;
+            found = true;
+            break;
+        }
+    }
+    cJSON_Delete(root);
+    return found;
+}
+
+double RestoolBench::GetPeakRssKb()
+{
+#ifdef __LINUX__
+    // ru_maxrss keeps the peak of the process before exec, so a child would report the memory of the benchmark
+    ifstream in("/proc/self/status");
+    string line;
+    const string key = "VmHWM:";
+    while (getline(in, line)) {
+        if (line.compare(0, key.size(), key) == 0) {
+            return strtod(line.c_str() + key.size(), nullptr);
+        }
+    }
+    return 0;
+#elif defined(_WIN32)
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    return usage.ru_maxrss / 1024.0; // bytes on macOS
+#endif
+}
+
+uint32_t RestoolBench::SaveResults() const
+{
+    cJSON *root = cJSON_CreateObject();
+    cJSON_AddStringToObject(root, "version", RESTOOL_VERSION.c_str());
+    cJSON *options = cJSON_CreateObject();
+    cJSON_AddItemToObject(root, "options", options);
+    cJSON_AddNumberToObject(options, "locales", options_.locales);
+    cJSON_AddNumberToObject(options, "elements", options_.elements);
+    cJSON_AddNumberToObject(options, "media", options_.media);
+    cJSON_AddNumberToObject(options, "rawfiles", options_.rawfiles);
+    cJSON_AddNumberToObject(options, "rawfileSize", options_.rawfileSize);
+    cJSON_AddNumberToObject(options, "hars", options_.hars);
+    cJSON_AddNumberToObject(options, "ids", options_.idDefined);
+    cJSON_AddNumberToObject(options, "thread", threadCount_);
+    cJSON_AddNumberToObject(options, "refStrings", refStrings_);
+    cJSON_AddNumberToObject(options, "copySmall", copySmall_);
+    cJSON_AddNumberToObject(options, "copyLarge", copyLarge_);
+    cJSON_AddStringToObject(options, "scaling", scaling_.c_str());
+    cJSON_AddStringToObject(options, "compression", compression_.c_str());
+    cJSON *results = cJSON_CreateArray();
+    cJSON_AddItemToObject(root, "results", results);
+    for (const auto &result : results_) {
+        cJSON *node = cJSON_CreateObject();
+        cJSON_AddStringToObject(node, "name", result.name.c_str());
+        cJSON_AddNumberToObject(node, "iterations", result.iterations);
+        cJSON_AddNumberToObject(node, "repeat", result.repeat);
+        cJSON_AddNumberToObject(node, "nsPerOp", result.nsPerOp);
+        cJSON_AddNumberToObject(node, "minNsPerOp", result.minNsPerOp);
+        for (const auto &metric : result.metrics) {
+            cJSON_AddNumberToObject(node, metric.first.c_str(), metric.second);
+        }
+        cJSON_AddItemToArray(results, node);
+    }
+    bool saved = ResourceUtil::SaveToJsonFile(resultPath_, root);
+    cJSON_Delete(root);
+    if (!saved) {
+        cerr << "Error: failed to save the results to '" << resultPath_ << "'." << endl;
+        return RESTOOL_ERROR;
+    }
+    cout << "Info: results are saved to '" << resultPath_ << "'." << endl;
+    return RESTOOL_SUCCESS;
+}
+
+void RestoolBench::ShowUsage()
+{
+    cout << "Usage: restool_bench [options]\n";
+    cout << "Generates a synthetic resource tree, packs it and runs the microbenchmarks.\n";
+    cout << "    --work <dir>          Directory of the generated resources and the pack output.\n";
+    cout << "    --output <file>       Result json file, default restool_bench.json.\n";
+    cout << "    --filter <text>       Only run the microbenchmarks whose name contains the text.\n";
+    cout << "    --iterations <n>      Calls of each microbenchmark per repeat, default 10000.\n";
+    cout << "    --repeat <n>          Repeats of each microbenchmark, the median is reported, default 5.\n";
+    cout << "    --thread <n>          Thread count of the pack.\n";
+    cout << "    --locales <n>         Locale directories of each module, default 8.\n";
+    cout << "    --elements <n>        String and integer entries of each element file, default 1000.\n";
+    cout << "    --media <n>           Media files of the entry module, default 200.\n";
+    cout << "    --rawfiles <n>        Rawfiles of the entry module, default 200.\n";
+    cout << "    --rawfile-size <n>    Size of each rawfile in bytes, default 4096.\n";
+    cout << "    --hars <n>            HAR modules the entry module depends on, default 4.\n";
+    cout << "    --ids <n>             Records of the id_defined.json, default 500.\n";
+    cout << "    --ref-strings <n>     Strings resolved by the reference benchmarks, default 500000.\n";
+    cout << "    --copy-small <n>      4 KiB files copied by the copy benchmarks, default 10000.\n";
+    cout << "    --copy-large <n>      4 MiB files copied by the copy benchmarks, default 16.\n";
+    cout << "    --scaling <list>      Thread counts of the packs in child processes, default 1,2,4,8, empty skips.\n";
+    cout << "    --compression <file>  Compression config of a transcoder, enables the transcode cache benchmark.\n";
+}
+}
+
+int main(int argc, char *argv[])
+{
+    try {
+        InitFaq(string(argv[0]));
+    } catch (const std::runtime_error &error) {
+        return RESTOOL_ERROR;
+    }
+    RestoolBench bench;
+    if (bench.Parse(argc, argv) != RESTOOL_SUCCESS) {
+        return RESTOOL_ERROR;
+    }
+    return bench.Run();
+}
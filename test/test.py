@@ -13,15 +13,150 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import filecmp
+import json
 import os
+import shutil
 import sys
 
 restool_cmd = sys.argv[1]
 output_path = sys.argv[2]
+# optional image transcoder library, the incremental build is also tested with media compression then
+transcoder_path = sys.argv[3] if len(sys.argv) > 3 else ""
 
-run_cmd = restool_cmd
-run_cmd = run_cmd + " -i  " + os.path.join(".")
-run_cmd = run_cmd + " -o " + output_path
-run_cmd = run_cmd + " -r " + os.path.join(output_path, "ResourceTable.h")
-run_cmd = run_cmd + " -p com.example.myapplication" 
-os.system(run_cmd)
\ No newline at end of file
+BUILD_STATE_FILE = ".restool_build_state"
+
+
+def pack(input_path, output, extra_args=""):
+    if not os.path.exists(output):
+        os.makedirs(output)
+    run_cmd = restool_cmd
+    run_cmd = run_cmd + " -i " + input_path
+    run_cmd = run_cmd + " -o " + output
+    run_cmd = run_cmd + " -r " + os.path.join(output, "ResourceTable.h")
+    run_cmd = run_cmd + " -p com.example.myapplication"
+    run_cmd = run_cmd + extra_args
+    return os.system(run_cmd)
+
+
+def list_files(path):
+    files = []
+    for root, _, names in os.walk(path):
+        for name in names:
+            if name != BUILD_STATE_FILE:
+                files.append(os.path.relpath(os.path.join(root, name), path))
+    return sorted(files)
+
+
+def same_output(left, right):
+    left_files = list_files(left)
+    if left_files != list_files(right):
+        print("different files: %s, %s" % (left, right))
+        return False
+    _, mismatch, errors = filecmp.cmpfiles(left, right, left_files, shallow=False)
+    if mismatch or errors:
+        print("different contents: %s" % (mismatch + errors))
+        return False
+    return True
+
+
+def write_compression_config(path):
+    config = {
+        "context": {"extensionPath": os.path.abspath(transcoder_path)},
+        "compression": {
+            "media": {"enable": True},
+            "filters": [{"method": {"type": "astc", "blocks": "4x4"}}]
+        }
+    }
+    with open(path, "w") as config_file:
+        json.dump(config, config_file)
+
+
+def test_incremental(name, extra_args=""):
+    # pack twice, change one string, then the incremental output must match a clean build
+    work_path = os.path.join(output_path, name)
+    if os.path.exists(work_path):
+        shutil.rmtree(work_path)
+    input_path = os.path.join(work_path, "input")
+    shutil.copytree(".", input_path, ignore=shutil.ignore_patterns("*.py", "benchmark"))
+    if extra_args.find("{config}") >= 0:
+        config_path = os.path.join(work_path, "compression.json")
+        write_compression_config(config_path)
+        extra_args = extra_args.replace("{config}", config_path)
+        # the app icon is transcoded again by every build, another image is reused from the last build
+        media_path = os.path.join(input_path, "resources", "base", "media")
+        shutil.copy(os.path.join(media_path, "icon.png"), os.path.join(media_path, "background.png"))
+    incremental_output = os.path.join(work_path, "incremental_output")
+    clean_output = os.path.join(work_path, "clean_output")
+    for _ in range(2):
+        if pack(input_path, incremental_output, " -f --incremental" + extra_args) != 0:
+            return False
+
+    strings_path = os.path.join(input_path, "resources", "base", "element", "strings.json")
+    with open(strings_path, "r") as strings_file:
+        content = strings_file.read()
+    with open(strings_path, "w") as strings_file:
+        strings_file.write(content.replace("my testing application", "my changed application"))
+
+    if pack(input_path, incremental_output, " -f --incremental" + extra_args) != 0:
+        return False
+    if pack(input_path, clean_output, " -f" + extra_args) != 0:
+        return False
+    return same_output(incremental_output, clean_output)
+
+
+def test_reconcile():
+    # a forced build keeps the unchanged outputs of the last build and removes the ones of removed sources
+    work_path = os.path.join(output_path, "reconcile")
+    if os.path.exists(work_path):
+        shutil.rmtree(work_path)
+    input_path = os.path.join(work_path, "input")
+    shutil.copytree(".", input_path, ignore=shutil.ignore_patterns("*.py", "benchmark"))
+    media_path = os.path.join(input_path, "resources", "base", "media")
+    shutil.copy(os.path.join(media_path, "icon.png"), os.path.join(media_path, "background.png"))
+    output = os.path.join(work_path, "output")
+    clean_output = os.path.join(work_path, "clean_output")
+    if pack(input_path, output, " -f") != 0:
+        return False
+
+    resources_path = os.path.join(output, "resources")
+    removed = os.path.join("base", "media", "background.png")
+    unchanged = [name for name in list_files(resources_path) if name != removed]
+    old_time = 1000000000
+    for name in unchanged:
+        os.utime(os.path.join(resources_path, name), (old_time, old_time))
+    os.remove(os.path.join(media_path, "background.png"))
+    if pack(input_path, output, " -f") != 0 or pack(input_path, clean_output, " -f") != 0:
+        return False
+    if os.path.exists(os.path.join(resources_path, removed)):
+        print("output of a removed source is kept: %s" % removed)
+        return False
+    touched = [name for name in unchanged if os.stat(os.path.join(resources_path, name)).st_mtime != old_time]
+    if touched:
+        print("unchanged outputs are written again: %s" % touched)
+        return False
+    if not same_output(output, clean_output):
+        return False
+
+    # a file that the last build did not write makes the build remove the resources directory as a whole
+    stray = os.path.join(resources_path, "base", "media", "stray.png")
+    shutil.copy(os.path.join(media_path, "icon.png"), stray)
+    if pack(input_path, output, " -f") != 0:
+        return False
+    if os.path.exists(stray):
+        print("stray output file is kept: %s" % stray)
+        return False
+    return same_output(output, clean_output)
+
+
+pack(".", output_path)
+if not test_incremental("incremental"):
+    print("incremental build test failed")
+    sys.exit(1)
+# the transcoded media are reused from the resources directory, not from the caches
+if transcoder_path and not test_incremental("incremental_compression", " --compressed-config {config}"):
+    print("incremental build test with compression failed")
+    sys.exit(1)
+if not test_reconcile():
+    print("reconcile test failed")
+    sys.exit(1)